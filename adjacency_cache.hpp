@@ -0,0 +1,215 @@
+#pragma once
+
+#include "instrumentation.hpp"
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+enum class cache_policy
+{
+    none,
+    materialize,
+    lru
+};
+
+struct cache_config
+{
+    cache_policy policy = cache_policy::none;
+    // Only used by cache_policy::lru.
+    std::size_t byte_budget = 0;
+};
+
+struct cache_stats
+{
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    std::size_t evictions = 0;
+    std::size_t invalidations = 0;
+    std::size_t entries = 0;
+    std::size_t bytes = 0;
+};
+
+// Memoized generator output per vertex. Entries are handed out as shared
+// pointers, so an entry evicted or invalidated by one thread stays valid for
+// a reader that is still iterating it. Everything except configure() is
+// thread-safe; configure() must not overlap with other calls.
+//
+// Entries, slots and the LRU list are allocated from the memory resource
+// given at construction. Evicted entries are returned to it, so pair LRU with
+// a pool rather than a monotonic arena.
+class adjacency_cache
+{
+public:
+    using entry = std::shared_ptr<const std::pmr::vector<int>>;
+
+private:
+    struct slot
+    {
+        entry neighbors;
+        std::list<int>::iterator position;
+    };
+
+    cache_config config;
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource();
+    std::pmr::vector<slot> slots{resource};
+    std::pmr::list<int> recency{resource};
+    cache_stats stats;
+    mutable std::mutex mutex;
+
+    static std::size_t entry_bytes(const std::pmr::vector<int> &neighbors)
+    {
+        return sizeof(slot) + sizeof(std::pmr::vector<int>) + neighbors.capacity() * sizeof(int);
+    }
+
+    void drop(int vertex_id)
+    {
+        slot &s = slots[vertex_id];
+        stats.bytes -= entry_bytes(*s.neighbors);
+        --stats.entries;
+        if (config.policy == cache_policy::lru)
+        {
+            recency.erase(s.position);
+        }
+        s.neighbors.reset();
+    }
+
+public:
+    adjacency_cache() = default;
+    explicit adjacency_cache(std::pmr::memory_resource *memory) : resource(memory) {}
+
+    // A copy keeps the configuration and memory resource but starts cold.
+    adjacency_cache(const adjacency_cache &other)
+        : config(other.configuration()), resource(other.resource), slots(resource), recency(resource)
+    {
+    }
+
+    adjacency_cache &operator=(const adjacency_cache &other)
+    {
+        if (this != &other)
+        {
+            configure(other.configuration());
+        }
+        return *this;
+    }
+
+    // Changing the configuration drops every entry and resets the counters.
+    void configure(const cache_config &new_config)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        config = new_config;
+        slots.clear();
+        recency.clear();
+        stats = cache_stats{};
+    }
+
+    cache_config configuration() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return config;
+    }
+
+    std::pmr::memory_resource *memory_resource() const
+    {
+        return resource;
+    }
+
+    bool enabled() const
+    {
+        return config.policy != cache_policy::none;
+    }
+
+    // Returns nullptr on a miss.
+    entry lookup(int vertex_id)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (vertex_id < static_cast<int>(slots.size()) && slots[vertex_id].neighbors)
+        {
+            ++stats.hits;
+            GRAPH_COUNT(cache_hits, 1);
+            slot &s = slots[vertex_id];
+            if (config.policy == cache_policy::lru)
+            {
+                recency.splice(recency.begin(), recency, s.position);
+            }
+            return s.neighbors;
+        }
+        ++stats.misses;
+        GRAPH_COUNT(cache_misses, 1);
+        return nullptr;
+    }
+
+    // Stores freshly generated neighbors and returns them as an entry. Under
+    // LRU, least recently used entries are evicted until the new one fits;
+    // an entry larger than the whole budget is returned without being kept.
+    entry store(int vertex_id, std::pmr::vector<int> neighbors)
+    {
+        entry result = std::allocate_shared<std::pmr::vector<int>>(
+            std::pmr::polymorphic_allocator<std::pmr::vector<int>>(resource), std::move(neighbors));
+        std::size_t bytes = entry_bytes(*result);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (config.policy == cache_policy::none)
+        {
+            return result;
+        }
+        if (config.policy == cache_policy::lru && bytes > config.byte_budget)
+        {
+            return result;
+        }
+
+        if (vertex_id >= static_cast<int>(slots.size()))
+        {
+            slots.resize(vertex_id + 1);
+        }
+        if (slots[vertex_id].neighbors)
+        {
+            drop(vertex_id);
+        }
+
+        if (config.policy == cache_policy::lru)
+        {
+            while (stats.bytes + bytes > config.byte_budget)
+            {
+                int victim = recency.back();
+                drop(victim);
+                ++stats.evictions;
+            }
+            recency.push_front(vertex_id);
+            slots[vertex_id].position = recency.begin();
+        }
+
+        slots[vertex_id].neighbors = result;
+        stats.bytes += bytes;
+        ++stats.entries;
+        return result;
+    }
+
+    void invalidate(int vertex_id)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (vertex_id < static_cast<int>(slots.size()) && slots[vertex_id].neighbors)
+        {
+            drop(vertex_id);
+            ++stats.invalidations;
+        }
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.invalidations += stats.entries;
+        slots.clear();
+        recency.clear();
+        stats.entries = 0;
+        stats.bytes = 0;
+    }
+
+    cache_stats statistics() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats;
+    }
+};
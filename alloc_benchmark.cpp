@@ -0,0 +1,156 @@
+#include <iostream>
+#include <fstream>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "undirected_graph.hpp"
+
+// Every heap allocation in the process goes through these, so the count
+// covers the graph, its generators and the algorithm scratch alike.
+static std::atomic<std::size_t> allocation_count{0};
+
+void *operator new(std::size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    std::size_t align = static_cast<std::size_t>(alignment);
+    if (void *p = std::aligned_alloc(align, (size + align - 1) / align * align))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+template <typename F>
+double time_ms(F &&f)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+}
+
+// Circulant graph with a materialized adjacency cache: the generators run
+// once and every traversal afterwards reads the cached vectors.
+void run_scenario(const std::string &name, std::pmr::memory_resource *resource, int n, int degree,
+                  const std::string &csv_file)
+{
+    std::size_t allocations_before = allocation_count.load();
+    int component_count = 0;
+
+    auto graph = new undirected_graph<int>(resource);
+    double build_ms = time_ms([&]()
+                       {
+        graph->set_cache_config({cache_policy::materialize});
+        for (int i = 0; i < n; ++i)
+        {
+            graph->add_vertex(i);
+        }
+        for (int i = 0; i < n; ++i)
+        {
+            graph->set_edge_generator(i, [i, n, degree]()
+                                      {
+                list_sequence<int> neighbors;
+                for (int k = 1; k <= degree / 2; ++k)
+                {
+                    neighbors.append_element((i + k) % n);
+                    neighbors.append_element((i - k + n) % n);
+                }
+                return neighbors; });
+        }
+        graph->find_component_labels(); });
+
+    double components_ms = time_ms([&]()
+                            {
+        for (int repeat = 0; repeat < 5; ++repeat)
+        {
+            component_count = graph->find_connected_components().get_length();
+        } });
+
+    double destroy_ms = time_ms([&]()
+                         { delete graph; });
+
+    std::size_t allocations = allocation_count.load() - allocations_before;
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    std::ofstream csv(csv_file, std::ios::app);
+    csv << name << ";" << n << ";" << degree << ";" << allocations << ";" << usage.ru_maxrss << ";"
+        << build_ms << ";" << components_ms << ";" << destroy_ms << "\n";
+    std::cout << name << ": " << allocations << " allocations, peak RSS " << usage.ru_maxrss << " KB, build "
+              << build_ms << " ms, 5x components " << components_ms << " ms, destroy " << destroy_ms
+              << " ms (" << component_count << " component)\n";
+}
+
+// Each scenario runs in its own process so peak RSS is not shared between
+// them.
+template <typename F>
+void in_child(F &&f)
+{
+    std::cout.flush();
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        f();
+        std::cout.flush();
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+}
+
+int main(int argc, char *argv[])
+{
+    int n = 1000000;
+    int degree = 8;
+    if (argc > 1)
+    {
+        n = std::stoi(argv[1]);
+    }
+
+    std::cout << "========================================\n";
+    std::cout << "  Benchmark: Allocations and Peak RSS\n";
+    std::cout << "========================================\n";
+
+    const std::string csv_file = "alloc_benchmark.csv";
+    {
+        std::ofstream csv(csv_file);
+        csv << "resource;vertices;degree;allocations;peak_rss_kb;build_ms;components_ms;destroy_ms\n";
+    }
+
+    in_child([&]()
+             { run_scenario("new_delete", std::pmr::new_delete_resource(), n, degree, csv_file); });
+
+    in_child([&]()
+             {
+        std::pmr::unsynchronized_pool_resource pool;
+        run_scenario("pool", &pool, n, degree, csv_file); });
+
+    in_child([&]()
+             {
+        std::pmr::monotonic_buffer_resource arena;
+        run_scenario("monotonic_arena", &arena, n, degree, csv_file); });
+
+    std::cout << "\nAllocation benchmark results saved to " << csv_file << "\n";
+    return 0;
+}
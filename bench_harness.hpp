@@ -0,0 +1,240 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Minimal benchmark harness: warmup runs, timed runs on steady_clock,
+// percentile summaries and a JSON report that can be diffed across
+// releases.
+
+// Keeps the compiler from discarding a result whose value is never used.
+template <typename T>
+inline void keep_result(const T &value)
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "r"(&value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+}
+
+struct bench_statistics
+{
+    int samples = 0;
+    double min = 0;
+    double mean = 0;
+    double stddev = 0;
+    double p50 = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double max = 0;
+};
+
+// Linear interpolation between the closest ranks of a sorted sample.
+inline double percentile(const std::vector<double> &sorted, double fraction)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+    double position = fraction * (sorted.size() - 1);
+    std::size_t below = static_cast<std::size_t>(position);
+    std::size_t above = std::min(below + 1, sorted.size() - 1);
+    return sorted[below] + (sorted[above] - sorted[below]) * (position - below);
+}
+
+inline bench_statistics summarize(std::vector<double> samples)
+{
+    bench_statistics stats;
+    stats.samples = static_cast<int>(samples.size());
+    if (samples.empty())
+    {
+        return stats;
+    }
+    std::sort(samples.begin(), samples.end());
+    double sum = 0;
+    for (double s : samples)
+    {
+        sum += s;
+    }
+    stats.mean = sum / samples.size();
+    double squares = 0;
+    for (double s : samples)
+    {
+        squares += (s - stats.mean) * (s - stats.mean);
+    }
+    stats.stddev = samples.size() > 1 ? std::sqrt(squares / (samples.size() - 1)) : 0.0;
+    stats.min = samples.front();
+    stats.max = samples.back();
+    stats.p50 = percentile(samples, 0.50);
+    stats.p90 = percentile(samples, 0.90);
+    stats.p99 = percentile(samples, 0.99);
+    return stats;
+}
+
+struct bench_config
+{
+    int warmup = 1;
+    int iterations = 10;
+};
+
+// Runs `run` warmup + iterations times and times each of the latter on its
+// own. `run` is a template argument, so no std::function call sits inside
+// the timed region.
+template <typename F>
+bench_statistics measure(const bench_config &config, F &&run)
+{
+    for (int i = 0; i < config.warmup; ++i)
+    {
+        run();
+    }
+    std::vector<double> samples;
+    samples.reserve(config.iterations);
+    for (int i = 0; i < config.iterations; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return summarize(std::move(samples));
+}
+
+inline void append_json_string(std::string &out, std::string_view text)
+{
+    out += '"';
+    for (char ch : text)
+    {
+        switch (ch)
+        {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(ch) < 0x20)
+            {
+                static const char hex[] = "0123456789abcdef";
+                out += "\\u00";
+                out += hex[(ch >> 4) & 0xf];
+                out += hex[ch & 0xf];
+            }
+            else
+            {
+                out += ch;
+            }
+        }
+    }
+    out += '"';
+}
+
+// Timings of named cases, grouped by phase (construction, query, export)
+// and input graph, plus free-form context such as compiler and threads.
+class bench_report
+{
+public:
+    struct entry
+    {
+        std::string name;
+        std::string phase;
+        std::string graph;
+        long long vertices = 0;
+        long long edges = 0;
+        bench_statistics stats;
+    };
+
+private:
+    std::vector<std::pair<std::string, std::string>> context;
+    std::vector<entry> entries;
+
+    static void append_number(std::string &out, double value)
+    {
+        if (!std::isfinite(value))
+        {
+            out += "null";
+            return;
+        }
+        char buffer[32];
+        int length = std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+        out.append(buffer, length);
+    }
+
+public:
+    void set_context(const std::string &key, const std::string &value)
+    {
+        for (auto &item : context)
+        {
+            if (item.first == key)
+            {
+                item.second = value;
+                return;
+            }
+        }
+        context.push_back({key, value});
+    }
+
+    void add(entry e) { entries.push_back(std::move(e)); }
+
+    const std::vector<entry> &results() const { return entries; }
+
+    std::string to_json() const
+    {
+        std::string out = "{\n  \"context\": {";
+        for (std::size_t i = 0; i < context.size(); ++i)
+        {
+            out += i == 0 ? "\n    " : ",\n    ";
+            append_json_string(out, context[i].first);
+            out += ": ";
+            append_json_string(out, context[i].second);
+        }
+        out += context.empty() ? "},\n" : "\n  },\n";
+        out += "  \"unit\": \"ms\",\n  \"benchmarks\": [";
+        for (std::size_t i = 0; i < entries.size(); ++i)
+        {
+            const entry &e = entries[i];
+            out += i == 0 ? "\n    {" : ",\n    {";
+            out += "\"name\": ";
+            append_json_string(out, e.name);
+            out += ", \"phase\": ";
+            append_json_string(out, e.phase);
+            out += ", \"graph\": ";
+            append_json_string(out, e.graph);
+            out += ", \"vertices\": " + std::to_string(e.vertices);
+            out += ", \"edges\": " + std::to_string(e.edges);
+            out += ", \"samples\": " + std::to_string(e.stats.samples);
+            std::pair<const char *, double> fields[] = {{"min", e.stats.min}, {"mean", e.stats.mean},
+                                                        {"stddev", e.stats.stddev}, {"p50", e.stats.p50},
+                                                        {"p90", e.stats.p90}, {"p99", e.stats.p99},
+                                                        {"max", e.stats.max}};
+            for (auto [key, value] : fields)
+            {
+                out += ", \"";
+                out += key;
+                out += "\": ";
+                append_number(out, value);
+            }
+            out += "}";
+        }
+        out += entries.empty() ? "]\n}\n" : "\n  ]\n}\n";
+        return out;
+    }
+
+    void write_json(std::ostream &stream) const { stream << to_json(); }
+};
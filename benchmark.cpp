@@ -3,7 +3,25 @@
 #include <vector>
 #include <random>
 #include <chrono>
+#include <cstdio>
+#include <algorithm>
 #include "undirected_graph.hpp"
+#include "csr_graph.hpp"
+#include "parallel_connected_components.hpp"
+#include "graph_builder.hpp"
+#include "graph_file.hpp"
+#include "shortest_paths.hpp"
+#include "multi_source_bfs.hpp"
+#include "biconnectivity.hpp"
+#include "level_spanning_forest.hpp"
+#include "vertex_reordering.hpp"
+#include "compressed_graph.hpp"
+#include "hybrid_graph.hpp"
+#include "triangles.hpp"
+#include "component_index.hpp"
+#include "graph_generators.hpp"
+#include "distributed_components.hpp"
+#include "spanning_forest.hpp"
 #include "dot_helper.hpp"
 
 template <typename T>
@@ -30,11 +48,1055 @@ void generate_random_graph(undirected_graph<T> &g, int n, double p, std::mt19937
     }
 }
 
+template <typename T>
+void generate_circulant_graph(undirected_graph<T> &g, int n, int degree)
+{
+    for (int i = 0; i < n; ++i)
+    {
+        g.add_vertex(i);
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        list_sequence<int> neighbors;
+        for (int k = 1; k <= degree / 2; ++k)
+        {
+            neighbors.append_element((i + k) % n);
+            neighbors.append_element((i - k + n) % n);
+        }
+        g.set_edge_generator(i, [neighbors]() mutable -> list_sequence<int>
+                             { return neighbors; });
+    }
+}
+
+template <typename F>
+double time_ms(F &&f)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+}
+
+// Per-edge cost of a full neighbor scan as the degree grows: indexed get(i)
+// over neighbors() versus for_each_neighbor on the generator graph and on CSR.
+void run_neighbor_scan_benchmark()
+{
+    const int n = 1024;
+    array_sequence<int> degrees = {4, 16, 64, 256, 512};
+
+    std::ofstream csv("benchmark_neighbors.csv");
+    csv << "degree;edges;indexed_ns_per_edge;visitor_ns_per_edge;csr_ns_per_edge\n";
+
+    std::cout << "\nNeighbor scan (n=" << n << ")\n";
+
+    for (int d : degrees)
+    {
+        undirected_graph<int> g;
+        generate_circulant_graph(g, n, d);
+        csr_graph<int> csr(g);
+        double edges = static_cast<double>(csr.arc_count());
+
+        long long checksum = 0;
+        double indexed_ms = time_ms([&]()
+                                    {
+            for (int v = 0; v < n; ++v)
+            {
+                auto neighbors = g.neighbors(v);
+                for (int i = 0; i < neighbors.get_length(); ++i)
+                {
+                    checksum += neighbors.get(i);
+                }
+            } });
+
+        double visitor_ms = time_ms([&]()
+                                    {
+            for (int v = 0; v < n; ++v)
+            {
+                g.for_each_neighbor(v, [&](int u)
+                                    { checksum += u; });
+            } });
+
+        double csr_ms = time_ms([&]()
+                                {
+            for (int v = 0; v < n; ++v)
+            {
+                csr.for_each_neighbor(v, [&](int u)
+                                      { checksum += u; });
+            } });
+
+        double indexed_ns = indexed_ms * 1e6 / edges;
+        double visitor_ns = visitor_ms * 1e6 / edges;
+        double csr_ns = csr_ms * 1e6 / edges;
+
+        csv << d << ";" << csr.arc_count() << ";" << indexed_ns << ";" << visitor_ns << ";" << csr_ns << "\n";
+        std::cout << "degree=" << d
+                  << ", indexed=" << indexed_ns << " ns/edge"
+                  << ", visitor=" << visitor_ns << " ns/edge"
+                  << ", csr=" << csr_ns << " ns/edge"
+                  << " (checksum " << checksum << ")\n";
+    }
+
+    std::cout << "Neighbor scan results saved to benchmark_neighbors.csv\n";
+}
+
+// Incremental add_vertex/set_edge_generator construction against the bulk
+// builder on the same random edge list.
+void run_construction_benchmark()
+{
+    const int n = 100000;
+    array_sequence<int> edge_counts = {100000, 500000, 1000000};
+    int threads = resolve_thread_count(0);
+
+    std::ofstream csv("benchmark_construction.csv");
+    csv << "n;edges;incremental_ms;bulk_ms;bulk_parallel_ms;threads\n";
+
+    std::cout << "\nGraph construction (n=" << n << ")\n";
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+
+    for (int m : edge_counts)
+    {
+        std::vector<std::pair<int, int>> edges;
+        edges.reserve(m);
+        for (int i = 0; i < m; ++i)
+        {
+            edges.push_back({pick(rng), pick(rng)});
+        }
+
+        double incremental_ms = time_ms([&]()
+                                        {
+            std::vector<list_sequence<int>> lists(n);
+            for (auto [u, v] : edges)
+            {
+                lists[u].append_element(v);
+                if (u != v)
+                {
+                    lists[v].append_element(u);
+                }
+            }
+
+            undirected_graph<int> g;
+            for (int i = 0; i < n; ++i)
+            {
+                g.add_vertex(i);
+            }
+            for (int i = 0; i < n; ++i)
+            {
+                g.set_edge_generator(i, [neighbors = lists[i]]() mutable -> list_sequence<int>
+                                     { return neighbors; });
+            } });
+
+        std::vector<int> payloads(n);
+        for (int i = 0; i < n; ++i)
+        {
+            payloads[i] = i;
+        }
+
+        build_options options;
+        double bulk_ms = time_ms([&]()
+                                 { build_csr_graph(payloads, edges, options); });
+
+        options.thread_count = threads;
+        double bulk_parallel_ms = time_ms([&]()
+                                          { build_csr_graph(payloads, edges, options); });
+
+        csv << n << ";" << m << ";" << incremental_ms << ";" << bulk_ms << ";" << bulk_parallel_ms << ";" << threads << "\n";
+        std::cout << "edges=" << m
+                  << ", incremental=" << incremental_ms << " ms"
+                  << ", bulk=" << bulk_ms << " ms"
+                  << ", bulk x" << threads << "=" << bulk_parallel_ms << " ms\n";
+    }
+
+    std::cout << "Construction results saved to benchmark_construction.csv\n";
+}
+
+// Opening a saved binary graph against rebuilding it from its edge list.
+void run_load_benchmark()
+{
+    const int n = 1000000;
+    array_sequence<int> edge_counts = {1000000, 5000000};
+    const std::string filename = "benchmark_graph.ugraph";
+
+    std::ofstream csv("benchmark_load.csv");
+    csv << "n;edges;file_mb;rebuild_ms;load_verified_ms;load_lazy_ms\n";
+
+    std::cout << "\nBinary load (n=" << n << ")\n";
+
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+
+    for (int m : edge_counts)
+    {
+        std::vector<std::pair<int, int>> edges;
+        edges.reserve(m);
+        for (int i = 0; i < m; ++i)
+        {
+            edges.push_back({pick(rng), pick(rng)});
+        }
+        std::vector<int> payloads(n, 0);
+
+        csr_graph<int> built;
+        double rebuild_ms = time_ms([&]()
+                                    { built = build_csr_graph(payloads, edges); });
+        save_graph_file(built, filename);
+
+        long long checksum = 0;
+        double verified_ms = time_ms([&]()
+                                     {
+            auto loaded = load_graph_file<int>(filename);
+            checksum += loaded.arc_count(); });
+
+        double lazy_ms = time_ms([&]()
+                                 {
+            auto loaded = load_graph_file<int>(filename, {false, false});
+            checksum += loaded.arc_count(); });
+
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+        double file_mb = static_cast<double>(file.tellg()) / (1024.0 * 1024.0);
+
+        csv << n << ";" << m << ";" << file_mb << ";" << rebuild_ms << ";" << verified_ms << ";" << lazy_ms << "\n";
+        std::cout << "edges=" << m << " (" << file_mb << " MB)"
+                  << ", rebuild=" << rebuild_ms << " ms"
+                  << ", load verified=" << verified_ms << " ms"
+                  << ", load lazy=" << lazy_ms << " ms"
+                  << " (checksum " << checksum << ")\n";
+    }
+
+    std::remove(filename.c_str());
+    std::cout << "Load results saved to benchmark_load.csv\n";
+}
+
+// Per-query latency of the shortest-path routines on one random graph.
+// Workspaces are warmed by a first query and reused, as a query service
+// would do.
+void run_shortest_path_benchmark()
+{
+    const int n = 1000000;
+    const int m = 5000000;
+
+    std::ofstream csv("benchmark_shortest_paths.csv");
+    csv << "query;n;edges;queries;mean_ms;p50_ms;p99_ms\n";
+
+    std::cout << "\nShortest paths (n=" << n << ", edges=" << m << ")\n";
+
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::uniform_int_distribution<int> weight(1, 1000);
+    std::vector<std::pair<int, int>> edges;
+    std::vector<std::tuple<int, int, int>> weighted_edges;
+    edges.reserve(m);
+    weighted_edges.reserve(m);
+    for (int i = 0; i < m; ++i)
+    {
+        int u = pick(rng);
+        int v = pick(rng);
+        edges.push_back({u, v});
+        weighted_edges.push_back({u, v, weight(rng)});
+    }
+    auto unweighted = build_csr_graph(std::vector<int>(n, 0), edges);
+    auto weighted = csr_graph<int, int>::from_weighted_edge_list(std::vector<int>(n, 0), weighted_edges);
+
+    std::vector<std::pair<int, int>> pairs(200);
+    for (auto &pair : pairs)
+    {
+        pair = {pick(rng), pick(rng)};
+    }
+
+    long long checksum = 0;
+    auto measure = [&](const std::string &name, int queries, auto &&query)
+    {
+        query(0);
+        std::vector<double> latencies;
+        for (int i = 0; i < queries; ++i)
+        {
+            latencies.push_back(time_ms([&]()
+                                        { query(i); }));
+        }
+        std::sort(latencies.begin(), latencies.end());
+        double mean = 0.0;
+        for (double latency : latencies)
+        {
+            mean += latency / queries;
+        }
+        double p50 = latencies[latencies.size() / 2];
+        double p99 = latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+
+        csv << name << ";" << n << ";" << m << ";" << queries << ";" << mean << ";" << p50 << ";" << p99 << "\n";
+        std::cout << name << ": mean=" << mean << " ms, p50=" << p50 << " ms, p99=" << p99 << " ms\n";
+    };
+
+    bfs_workspace bfs;
+    measure("bfs_top_down", 10, [&](int i)
+            {
+        breadth_first_search(unweighted, pairs[i].first, bfs, false);
+        checksum += bfs.touched.size(); });
+    measure("bfs_direction_optimizing", 10, [&](int i)
+            {
+        breadth_first_search(unweighted, pairs[i].first, bfs, true);
+        checksum += bfs.touched.size(); });
+
+    dijkstra_workspace<long long> sssp;
+    measure("dijkstra_dary", 5, [&](int i)
+            {
+        dijkstra(weighted, pairs[i].first, sssp, -1, dijkstra_heap::dary);
+        checksum += sssp.distance(pairs[i].second); });
+    measure("dijkstra_radix", 5, [&](int i)
+            {
+        dijkstra(weighted, pairs[i].first, sssp, -1, dijkstra_heap::radix);
+        checksum += sssp.distance(pairs[i].second); });
+
+    int queries = static_cast<int>(pairs.size());
+    measure("point_to_point_dijkstra", 20, [&](int i)
+            {
+        dijkstra(weighted, pairs[i].first, sssp, pairs[i].second);
+        checksum += sssp.distance(pairs[i].second); });
+
+    bidirectional_workspace<long long> pair_search;
+    measure("point_to_point_bidirectional", queries, [&](int i)
+            { checksum += bidirectional_search(weighted, pairs[i].first, pairs[i].second, pair_search); });
+    measure("point_to_point_bidirectional_bfs", queries, [&](int i)
+            { checksum += bidirectional_search(unweighted, pairs[i].first, pairs[i].second, pair_search); });
+
+    std::cout << "(checksum " << checksum << ")\n";
+    std::cout << "Shortest path results saved to benchmark_shortest_paths.csv\n";
+}
+
+// Distances from many sources: one BFS per source against bit-parallel
+// batches of 64 and 256 sources, sequential and on every core.
+void run_multi_source_bfs_benchmark()
+{
+    const int n = 200000;
+    const int m = 1000000;
+    const int source_count = 256;
+    int threads = resolve_thread_count(0);
+
+    std::ofstream csv("benchmark_multi_source_bfs.csv");
+    csv << "method;n;edges;sources;threads;time_ms;ms_per_source\n";
+
+    std::cout << "\nMulti-source BFS (n=" << n << ", edges=" << m << ", sources=" << source_count << ")\n";
+
+    std::mt19937 rng(23);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(m);
+    for (int i = 0; i < m; ++i)
+    {
+        edges.push_back({pick(rng), pick(rng)});
+    }
+    auto csr = build_csr_graph(std::vector<int>(n, 0), edges);
+    std::vector<int> sources(source_count);
+    for (int &s : sources)
+    {
+        s = pick(rng);
+    }
+
+    long long checksum = 0;
+    auto report = [&](const std::string &method, int method_threads, double ms)
+    {
+        csv << method << ";" << n << ";" << m << ";" << source_count << ";" << method_threads << ";" << ms << ";"
+            << ms / source_count << "\n";
+        std::cout << method << " (threads=" << method_threads << "): " << ms << " ms, " << ms / source_count
+                  << " ms/source\n";
+    };
+
+    bfs_workspace workspace;
+    report("single_source_bfs", 1, time_ms([&]()
+                                           {
+        for (int s : sources)
+        {
+            breadth_first_search(csr, s, workspace, false);
+            checksum += workspace.touched.size();
+        } }));
+
+    report("ms_bfs_64", 1, time_ms([&]()
+                                   { checksum += multi_source_distances<1>(csr, sources).at(0, 0); }));
+    report("ms_bfs_256", 1, time_ms([&]()
+                                    { checksum += multi_source_distances<4>(csr, sources).at(0, 0); }));
+    report("ms_bfs_64", threads, time_ms([&]()
+                                         { checksum += multi_source_distances<1>(csr, sources, threads).at(0, 0); }));
+
+    std::cout << "(checksum " << checksum << ")\n";
+    std::cout << "Multi-source BFS results saved to benchmark_multi_source_bfs.csv\n";
+}
+
+// Bridges, articulation points and blocks in one iterative DFS, next to a
+// plain connected-components pass over the same graph. The path case is as
+// deep as a DFS can get.
+void run_biconnectivity_benchmark()
+{
+    std::ofstream csv("benchmark_biconnectivity.csv");
+    csv << "graph;n;edges;components_ms;biconnectivity_ms;bridges;articulation_points;blocks\n";
+
+    std::cout << "\nBiconnectivity\n";
+
+    std::mt19937 rng(29);
+    biconnectivity_workspace workspace;
+    components_workspace components;
+
+    auto measure = [&](const std::string &name, const csr_graph<int> &csr, std::size_t m)
+    {
+        long long checksum = 0;
+        double components_ms = time_ms([&]()
+                                       { checksum += component_labels(csr, components).size(); });
+        biconnectivity_result result;
+        double biconnectivity_ms = time_ms([&]()
+                                           { result = biconnectivity(csr, workspace); });
+
+        csv << name << ";" << csr.vertex_count() << ";" << m << ";" << components_ms << ";" << biconnectivity_ms
+            << ";" << result.bridges.size() << ";" << result.articulation_points.size() << ";"
+            << result.block_count() << "\n";
+        std::cout << name << " n=" << csr.vertex_count() << " edges=" << m
+                  << ": components=" << components_ms << " ms"
+                  << ", biconnectivity=" << biconnectivity_ms << " ms"
+                  << " (" << result.bridges.size() << " bridges, " << result.articulation_points.size()
+                  << " articulation points, " << result.block_count() << " blocks; checksum " << checksum << ")\n";
+    };
+
+    const int n = 1000000;
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    array_sequence<int> edge_counts = {1000000, 2000000, 5000000};
+    for (int m : edge_counts)
+    {
+        std::vector<std::pair<int, int>> edges;
+        edges.reserve(m);
+        for (int i = 0; i < m; ++i)
+        {
+            edges.push_back({pick(rng), pick(rng)});
+        }
+        measure("random", build_csr_graph(std::vector<int>(n, 0), edges), m);
+    }
+
+    const int path_length = 10000000;
+    {
+        std::vector<std::pair<int, int>> edges;
+        edges.reserve(path_length - 1);
+        for (int v = 0; v + 1 < path_length; ++v)
+        {
+            edges.push_back({v, v + 1});
+        }
+        measure("path", build_csr_graph(std::vector<int>(path_length, 0), edges), edges.size());
+    }
+
+    std::cout << "Biconnectivity results saved to benchmark_biconnectivity.csv\n";
+}
+
+void run_dynamic_connectivity_benchmark()
+{
+    std::ofstream csv("benchmark_dynamic_connectivity.csv");
+    csv << "n;edges;updates;dynamic_ops_per_s;recompute_ms;recompute_ops_per_s;components\n";
+
+    std::cout << "\nDynamic connectivity (mixed inserts and deletes)\n";
+
+    std::mt19937 rng(37);
+    components_workspace components;
+    array_sequence<int> sizes = {10000, 100000, 1000000};
+    for (int n : sizes)
+    {
+        std::uniform_int_distribution<int> pick(0, n - 1);
+        level_spanning_forest forest(n);
+        std::vector<std::pair<int, int>> present;
+        present.reserve(n);
+        for (int i = 0; i < n; ++i)
+        {
+            std::pair<int, int> e{pick(rng), pick(rng)};
+            forest.insert_edge(e.first, e.second);
+            present.push_back(e);
+        }
+
+        // Half inserts, half deletes of a random present edge, so the edge
+        // count stays at n and components keep splitting and merging.
+        const int updates = 200000;
+        double dynamic_ms = time_ms([&]()
+                                    {
+            for (int i = 0; i < updates; ++i)
+            {
+                if (i % 2 == 0)
+                {
+                    std::pair<int, int> e{pick(rng), pick(rng)};
+                    forest.insert_edge(e.first, e.second);
+                    present.push_back(e);
+                }
+                else
+                {
+                    std::size_t j = rng() % present.size();
+                    forest.delete_edge(present[j].first, present[j].second);
+                    present[j] = present.back();
+                    present.pop_back();
+                }
+            } });
+
+        // The static alternative rebuilds and relabels after every update.
+        long long checksum = 0;
+        double recompute_ms = time_ms([&]()
+                                      {
+            auto csr = csr_graph<int>::from_edge_list(std::vector<int>(n, 0), present);
+            checksum += component_labels(csr, components).size(); });
+
+        double dynamic_rate = updates / (dynamic_ms / 1000.0);
+        double recompute_rate = 1000.0 / recompute_ms;
+        csv << n << ";" << present.size() << ";" << updates << ";" << dynamic_rate << ";" << recompute_ms << ";"
+            << recompute_rate << ";" << forest.component_count() << "\n";
+        std::cout << "n=" << n << " edges=" << present.size() << ": dynamic=" << dynamic_rate << " ops/s"
+                  << ", recompute=" << recompute_ms << " ms (" << recompute_rate << " ops/s)"
+                  << ", " << forest.component_count() << " components, " << forest.level_count()
+                  << " levels (checksum " << checksum << ")\n";
+    }
+
+    std::cout << "Dynamic connectivity results saved to benchmark_dynamic_connectivity.csv\n";
+}
+
+void run_reordering_benchmark()
+{
+    std::ofstream csv("benchmark_reordering.csv");
+    csv << "graph;order;n;edges;order_ms;relabel_ms;components_ms;bfs_ms\n";
+
+    std::cout << "\nVertex reordering\n";
+
+    std::mt19937 rng(41);
+    components_workspace components;
+    bfs_workspace bfs;
+
+    auto measure = [&](const std::string &graph_name, const csr_graph<int> &csr, std::size_t m)
+    {
+        auto run = [&](const std::string &order_name, const csr_graph<int> &gr, int source, double order_ms,
+                       double relabel_ms)
+        {
+            long long checksum = 0;
+            double components_ms = time_ms([&]()
+                                           { checksum += component_labels(gr, components).size(); });
+            double bfs_ms = time_ms([&]()
+                                    { breadth_first_search(gr, source, bfs); });
+            csv << graph_name << ";" << order_name << ";" << gr.vertex_count() << ";" << m << ";" << order_ms << ";"
+                << relabel_ms << ";" << components_ms << ";" << bfs_ms << "\n";
+            std::cout << graph_name << " " << order_name << ": order=" << order_ms << " ms, relabel=" << relabel_ms
+                      << " ms, components=" << components_ms << " ms, bfs=" << bfs_ms << " ms (checksum "
+                      << checksum << ")\n";
+        };
+
+        run("input", csr, 0, 0, 0);
+        std::pair<vertex_order, std::string> methods[] = {{vertex_order::reverse_cuthill_mckee, "rcm"},
+                                                          {vertex_order::degree_descending, "degree"},
+                                                          {vertex_order::gorder, "gorder"}};
+        for (const auto &[method, name] : methods)
+        {
+            std::vector<int> order;
+            double order_ms = time_ms([&]()
+                                      { order = compute_vertex_order(csr, method); });
+            reordered_graph<int> reordered;
+            double relabel_ms = time_ms([&]()
+                                        { reordered = reorder_vertices(csr, std::span<const int>(order)); });
+            run(name, reordered.graph, reordered.reordered_id(0), order_ms, relabel_ms);
+        }
+    };
+
+    // A 1000 x 1000 grid whose labels were handed out in random order, as
+    // when vertices are added in arrival order.
+    const int side = 1000;
+    const int n = side * side;
+    std::vector<int> label(n);
+    for (int v = 0; v < n; ++v)
+    {
+        label[v] = v;
+    }
+    std::shuffle(label.begin(), label.end(), rng);
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(2 * n);
+    for (int r = 0; r < side; ++r)
+    {
+        for (int c = 0; c < side; ++c)
+        {
+            if (c + 1 < side)
+            {
+                edges.push_back({label[r * side + c], label[r * side + c + 1]});
+            }
+            if (r + 1 < side)
+            {
+                edges.push_back({label[r * side + c], label[(r + 1) * side + c]});
+            }
+        }
+    }
+    measure("shuffled_grid", build_csr_graph(std::vector<int>(n, 0), edges), edges.size());
+
+    const int m = 5000000;
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    edges.clear();
+    for (int i = 0; i < m; ++i)
+    {
+        edges.push_back({pick(rng), pick(rng)});
+    }
+    measure("random", build_csr_graph(std::vector<int>(n, 0), edges), m);
+
+    std::cout << "Reordering results saved to benchmark_reordering.csv\n";
+}
+
+void run_compression_benchmark()
+{
+    std::ofstream csv("benchmark_compression.csv");
+    csv << "graph;n;arcs;csr_bytes_per_arc;compressed_bytes_per_arc;encode_ms;csr_scan_ms;compressed_scan_ms;"
+           "decode_marcs_per_s;csr_components_ms;compressed_components_ms\n";
+
+    std::cout << "\nAdjacency compression\n";
+
+    std::mt19937 rng(43);
+    components_workspace components;
+
+    auto measure = [&](const std::string &name, const csr_graph<int> &csr)
+    {
+        compressed_graph<int> compressed;
+        double encode_ms = time_ms([&]()
+                                   { compressed = compressed_graph<int>(csr); });
+
+        long long csr_sum = 0;
+        long long compressed_sum = 0;
+        auto scan = [&](const auto &gr, long long &sum)
+        {
+            for (int v = 0; v < gr.vertex_count(); ++v)
+            {
+                gr.for_each_neighbor(v, [&](int u)
+                                     { sum += u; });
+            }
+        };
+        double csr_scan_ms = time_ms([&]()
+                                     { scan(csr, csr_sum); });
+        double compressed_scan_ms = time_ms([&]()
+                                            { scan(compressed, compressed_sum); });
+        if (csr_sum != compressed_sum)
+        {
+            throw std::runtime_error("Compressed adjacency does not match CSR");
+        }
+
+        double csr_components_ms = time_ms([&]()
+                                           { component_labels(csr, components); });
+        double compressed_components_ms = time_ms([&]()
+                                                  { component_labels(compressed, components); });
+
+        double arcs = static_cast<double>(csr.arc_count());
+        double csr_bytes = (csr.target_array().size_bytes() + csr.offset_array().size_bytes()) / arcs;
+        double decode_rate = arcs / (compressed_scan_ms / 1000.0) / 1e6;
+        csv << name << ";" << csr.vertex_count() << ";" << csr.arc_count() << ";" << csr_bytes << ";"
+            << compressed.bytes_per_arc() << ";" << encode_ms << ";" << csr_scan_ms << ";" << compressed_scan_ms
+            << ";" << decode_rate << ";" << csr_components_ms << ";" << compressed_components_ms << "\n";
+        std::cout << name << " n=" << csr.vertex_count() << " arcs=" << csr.arc_count()
+                  << ": bytes/arc csr=" << csr_bytes << " compressed=" << compressed.bytes_per_arc()
+                  << ", encode=" << encode_ms << " ms, scan csr=" << csr_scan_ms << " ms compressed="
+                  << compressed_scan_ms << " ms (" << decode_rate << " M arcs/s), components csr="
+                  << csr_components_ms << " ms compressed=" << compressed_components_ms << " ms\n";
+    };
+
+    const int n = 1000000;
+    const int m = 5000000;
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(m);
+    for (int i = 0; i < m; ++i)
+    {
+        edges.push_back({pick(rng), pick(rng)});
+    }
+    auto random = build_csr_graph(std::vector<int>(n, 0), edges);
+    measure("random", random);
+    // Gaps shrink once neighbors get nearby labels.
+    measure("random_rcm", reorder_vertices(random, vertex_order::reverse_cuthill_mckee).graph);
+
+    const int side = 1000;
+    edges.clear();
+    for (int r = 0; r < side; ++r)
+    {
+        for (int c = 0; c < side; ++c)
+        {
+            if (c + 1 < side)
+            {
+                edges.push_back({r * side + c, r * side + c + 1});
+            }
+            if (r + 1 < side)
+            {
+                edges.push_back({r * side + c, (r + 1) * side + c});
+            }
+        }
+    }
+    measure("grid", build_csr_graph(std::vector<int>(side * side, 0), edges));
+
+    std::cout << "Compression results saved to benchmark_compression.csv\n";
+}
+
+void run_hybrid_adjacency_benchmark()
+{
+    const int n = 4000;
+
+    std::ofstream csv("benchmark_hybrid_adjacency.csv");
+    csv << "n;density;arcs;dense_vertices;csr_bytes;hybrid_bytes;csr_components_ms;hybrid_components_ms;"
+           "csr_bfs_ms;hybrid_bfs_ms;csr_common_ms;hybrid_common_ms\n";
+
+    std::cout << "\nHybrid bitmap adjacency (n=" << n << ")\n";
+
+    std::mt19937 rng(47);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    components_workspace components;
+    bfs_workspace bfs;
+
+    std::vector<std::pair<int, int>> pairs(20000);
+    for (auto &pair : pairs)
+    {
+        pair = {pick(rng), pick(rng)};
+    }
+
+    array_sequence<double> densities = {0.01, 0.05, 0.1, 0.3, 0.5, 0.7, 0.9};
+    for (double p : densities)
+    {
+        std::vector<std::pair<int, int>> edges;
+        for (int u = 0; u < n; ++u)
+        {
+            for (int v = u + 1; v < n; ++v)
+            {
+                if (coin(rng) < p)
+                {
+                    edges.push_back({u, v});
+                }
+            }
+        }
+        auto csr = build_csr_graph(std::vector<int>(n, 0), edges);
+        hybrid_graph<int> hybrid(csr);
+
+        long long checksum = 0;
+        double csr_components_ms = time_ms([&]()
+                                           { checksum += component_labels(csr, components).size(); });
+        double hybrid_components_ms = time_ms([&]()
+                                              { checksum += hybrid.find_component_labels().size(); });
+        double csr_bfs_ms = time_ms([&]()
+                                    { breadth_first_search(csr, 0, bfs, false); });
+        double hybrid_bfs_ms = time_ms([&]()
+                                       { checksum += hybrid.bfs_distances(0).size(); });
+
+        // Sorted-list intersection as the CSR baseline for set operations.
+        std::vector<int> a;
+        std::vector<int> b;
+        double csr_common_ms = time_ms([&]()
+                                       {
+            for (auto [u, v] : pairs)
+            {
+                auto nu = csr.neighbors(u);
+                auto nv = csr.neighbors(v);
+                a.assign(nu.begin(), nu.end());
+                b.assign(nv.begin(), nv.end());
+                std::sort(a.begin(), a.end());
+                std::sort(b.begin(), b.end());
+                std::size_t i = 0;
+                std::size_t j = 0;
+                while (i < a.size() && j < b.size())
+                {
+                    if (a[i] < b[j])
+                        ++i;
+                    else if (b[j] < a[i])
+                        ++j;
+                    else
+                    {
+                        ++checksum;
+                        ++i;
+                        ++j;
+                    }
+                }
+            } });
+        double hybrid_common_ms = time_ms([&]()
+                                          {
+            for (auto [u, v] : pairs)
+            {
+                checksum -= hybrid.common_neighbor_count(u, v);
+            } });
+
+        std::size_t csr_bytes = csr.target_array().size_bytes() + csr.offset_array().size_bytes();
+        csv << n << ";" << p << ";" << csr.arc_count() << ";" << hybrid.dense_vertex_count() << ";" << csr_bytes
+            << ";" << hybrid.adjacency_bytes() << ";" << csr_components_ms << ";" << hybrid_components_ms << ";"
+            << csr_bfs_ms << ";" << hybrid_bfs_ms << ";" << csr_common_ms << ";" << hybrid_common_ms << "\n";
+        std::cout << "density=" << p << " arcs=" << csr.arc_count() << " dense=" << hybrid.dense_vertex_count()
+                  << ": bytes csr=" << csr_bytes << " hybrid=" << hybrid.adjacency_bytes()
+                  << ", components csr=" << csr_components_ms << " ms hybrid=" << hybrid_components_ms
+                  << " ms, bfs csr=" << csr_bfs_ms << " ms hybrid=" << hybrid_bfs_ms
+                  << " ms, common neighbors csr=" << csr_common_ms << " ms hybrid=" << hybrid_common_ms
+                  << " ms (checksum " << checksum << ")\n";
+    }
+
+    std::cout << "Hybrid adjacency results saved to benchmark_hybrid_adjacency.csv\n";
+}
+
+// Triangles and clustering over the same size/density sweep as the
+// connected components benchmark. to_dot is timed as well, since exporting
+// was the previous way to get these numbers.
+void run_triangle_benchmark(const array_sequence<int> &sizes, const array_sequence<double> &densities, int threads)
+{
+    std::ofstream csv("benchmark_triangles.csv");
+    csv << "n;edge_density;triangles;global_clustering;average_clustering;serial_ms;threads;parallel_ms;speedup;"
+           "to_dot_ms\n";
+
+    std::cout << "\nTriangle counting and clustering (" << threads << " threads)\n";
+
+    std::mt19937 rng(53);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    for (int n : sizes)
+    {
+        for (double p : densities)
+        {
+            std::vector<std::pair<int, int>> edges;
+            for (int u = 0; u < n; ++u)
+            {
+                for (int v = u + 1; v < n; ++v)
+                {
+                    if (coin(rng) < p)
+                    {
+                        edges.push_back({u, v});
+                    }
+                }
+            }
+            auto graph = build_undirected_graph(std::vector<int>(n, 0), edges);
+
+            clustering_coefficients clustering;
+            double serial_ms = time_ms([&]()
+                                       { clustering = compute_clustering(graph, 1); });
+            clustering_coefficients parallel;
+            double parallel_ms = time_ms([&]()
+                                         { parallel = compute_clustering(graph, threads); });
+            if (parallel.triangles != clustering.triangles)
+            {
+                throw std::runtime_error("Parallel triangle count differs");
+            }
+            std::size_t dot_size = 0;
+            double dot_ms = time_ms([&]()
+                                    { dot_size = to_dot(graph).size(); });
+            double speedup = parallel_ms > 0.0 ? serial_ms / parallel_ms : 0.0;
+
+            csv << n << ";" << p << ";" << clustering.triangles << ";" << clustering.global << ";"
+                << clustering.average << ";" << serial_ms << ";" << threads << ";" << parallel_ms << ";" << speedup
+                << ";" << dot_ms << "\n";
+            std::cout << "n=" << n << ", p=" << p << ": triangles=" << clustering.triangles
+                      << ", global=" << clustering.global << ", average=" << clustering.average
+                      << ", serial=" << serial_ms << " ms, parallel=" << parallel_ms << " ms (x" << speedup
+                      << "), to_dot=" << dot_ms << " ms (" << dot_size << " bytes)\n";
+        }
+    }
+
+    std::cout << "Triangle results saved to benchmark_triangles.csv\n";
+}
+
+void run_component_index_benchmark(int threads)
+{
+    std::ofstream csv("benchmark_component_index.csv");
+    csv << "n;edges;components;queries;list_scan_ns_per_query;build_ms;parallel_build_ms;single_ns_per_query;"
+           "batch_ns_per_query;size_batch_ns_per_query\n";
+
+    std::cout << "\nComponent index queries\n";
+
+    std::mt19937 rng(43);
+    const int queries = 10000000;
+    array_sequence<int> vertex_counts = {100000, 1000000};
+    for (int n : vertex_counts)
+    {
+        std::uniform_int_distribution<int> pick(0, n - 1);
+        // As many random edges as vertices leaves a giant component next
+        // to many small ones.
+        std::vector<std::pair<int, int>> edges;
+        for (int i = 0; i < n; ++i)
+        {
+            edges.push_back({pick(rng), pick(rng)});
+        }
+        auto csr = build_csr_graph(std::vector<int>(n, 0), edges);
+
+        std::vector<std::pair<int, int>> pairs(queries);
+        std::vector<int> vertices(queries);
+        for (int i = 0; i < queries; ++i)
+        {
+            pairs[i] = {pick(rng), pick(rng)};
+            vertices[i] = pick(rng);
+        }
+
+        // Without an index a query has to find both vertices in the
+        // component lists; a few hundred are enough to see the cost.
+        const int list_queries = 200;
+        long long checksum = 0;
+        double list_ms = time_ms([&]()
+                                 {
+            auto components = csr.find_connected_components();
+            for (int q = 0; q < list_queries; ++q)
+            {
+                int found_u = -1;
+                int found_v = -1;
+                for (int c = 0; c < components.get_length(); ++c)
+                {
+                    for (int x : components.get(c))
+                    {
+                        found_u = x == pairs[q].first ? c : found_u;
+                        found_v = x == pairs[q].second ? c : found_v;
+                    }
+                }
+                checksum += found_u == found_v;
+            } });
+
+        component_index index;
+        double build_ms = time_ms([&]()
+                                  { index = component_index::build(csr); });
+        double parallel_build_ms = time_ms([&]()
+                                           { checksum += component_index::build(csr, threads).component_count(); });
+
+        double single_ms = time_ms([&]()
+                                   {
+            for (const auto &[u, v] : pairs)
+            {
+                checksum += index.connected(u, v);
+            } });
+        std::vector<char> answers(queries);
+        double batch_ms = time_ms([&]()
+                                  { index.connected_batch(pairs, answers); });
+        std::vector<int> sizes(queries);
+        double size_batch_ms = time_ms([&]()
+                                       { index.component_size_batch(vertices, sizes); });
+        checksum += answers[queries / 2] + sizes[queries / 3];
+
+        double list_ns = list_ms * 1e6 / list_queries;
+        double single_ns = single_ms * 1e6 / queries;
+        double batch_ns = batch_ms * 1e6 / queries;
+        double size_batch_ns = size_batch_ms * 1e6 / queries;
+        csv << n << ";" << edges.size() << ";" << index.component_count() << ";" << queries << ";" << list_ns << ";"
+            << build_ms << ";" << parallel_build_ms << ";" << single_ns << ";" << batch_ns << ";" << size_batch_ns
+            << "\n";
+        std::cout << "n=" << n << " components=" << index.component_count() << ": list scan=" << list_ns
+                  << " ns/query, build=" << build_ms << " ms (parallel " << parallel_build_ms
+                  << " ms), single=" << single_ns << " ns/query, batch=" << batch_ns
+                  << " ns/query, size batch=" << size_batch_ns << " ns/query (checksum " << checksum << ")\n";
+    }
+
+    std::cout << "Component index results saved to benchmark_component_index.csv\n";
+}
+
+void run_partition_benchmark()
+{
+    std::ofstream csv("benchmark_partition.csv");
+    csv << "graph;n;edges;method;shards;partition_ms;cut_fraction;imbalance;ghosts;shard_build_ms;components_ms;"
+           "in_process_ms;processes_ms;rounds;messages\n";
+
+    std::cout << "\nPartitioning and sharded components\n";
+
+    std::mt19937 rng(61);
+    auto measure = [&](const std::string &name, const csr_graph<int> &csr, std::size_t m)
+    {
+        std::vector<int> expected;
+        double components_ms = time_ms([&]()
+                                       { expected = component_labels(csr); });
+        for (partition_method method : {partition_method::ldg, partition_method::fennel})
+        {
+            const char *method_name = method == partition_method::ldg ? "ldg" : "fennel";
+            array_sequence<int> shard_counts = {2, 4, 8};
+            for (int k : shard_counts)
+            {
+                graph_partition partition;
+                double partition_ms = time_ms([&]()
+                                              { partition = partition_graph(csr, k, {method}); });
+                partition_quality quality = evaluate_partition(csr, partition);
+                std::vector<graph_shard> shards;
+                double shard_build_ms = time_ms([&]()
+                                                { shards = build_shards(csr, partition); });
+                long long ghosts = 0;
+                for (const graph_shard &shard : shards)
+                {
+                    ghosts += shard.ghost_count();
+                }
+
+                distributed_components_result local;
+                double in_process_ms = time_ms([&]()
+                                               { local = distributed_component_labels(shards); });
+                distributed_components_result forked;
+                double processes_ms = time_ms([&]()
+                                              { forked = sharded_component_labels(shards); });
+                if (local.labels != expected || forked.labels != expected)
+                {
+                    std::cout << "  labels differ from component_labels!\n";
+                }
+
+                csv << name << ";" << csr.vertex_count() << ";" << m << ";" << method_name << ";" << k << ";"
+                    << partition_ms << ";" << quality.cut_fraction << ";" << quality.imbalance << ";" << ghosts << ";"
+                    << shard_build_ms << ";" << components_ms << ";" << in_process_ms << ";" << processes_ms << ";"
+                    << forked.rounds << ";" << forked.messages << "\n";
+                std::cout << name << " " << method_name << " k=" << k << ": partition=" << partition_ms
+                          << " ms, cut=" << quality.cut_fraction << ", imbalance=" << quality.imbalance
+                          << ", ghosts=" << ghosts << ", components=" << components_ms
+                          << " ms, in-process=" << in_process_ms << " ms, processes=" << processes_ms << " ms ("
+                          << forked.rounds << " rounds, " << forked.messages << " messages)\n";
+            }
+        }
+    };
+
+    const int side = 1000;
+    auto grid = grid_edges(side, side);
+    measure("grid", build_csr_graph(std::vector<int>(side * side, 0), grid), grid.size());
+
+    const int n = 1000000;
+    auto random = erdos_renyi_edges(n, 4.0 / n, rng);
+    measure("random", build_csr_graph(std::vector<int>(n, 0), random), random.size());
+
+    std::cout << "Partition results saved to benchmark_partition.csv\n";
+}
+
+void run_spanning_forest_benchmark(const array_sequence<int> &sizes, const array_sequence<double> &densities,
+                                   int threads)
+{
+    std::ofstream csv("benchmark_spanning_forest.csv");
+    csv << "n;edge_density;edges;components;total_weight;kruskal_ms;parallel_kruskal_ms;boruvka_ms;"
+           "parallel_boruvka_ms;threads\n";
+
+    std::cout << "\nMinimum spanning forest (" << threads << " threads)\n";
+
+    std::mt19937 rng(67);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    std::uniform_int_distribution<int> weight(1, 1000);
+    for (int n : sizes)
+    {
+        for (double p : densities)
+        {
+            std::vector<std::tuple<int, int, int>> edges;
+            for (int u = 0; u < n; ++u)
+            {
+                for (int v = u + 1; v < n; ++v)
+                {
+                    if (coin(rng) < p)
+                    {
+                        edges.push_back({u, v, weight(rng)});
+                    }
+                }
+            }
+            auto csr = csr_graph<int, int>::from_weighted_edge_list(std::vector<int>(n, 0), edges);
+
+            spanning_forest<int> kruskal;
+            double kruskal_ms = time_ms([&]()
+                                        { kruskal = kruskal_spanning_forest(csr, 1); });
+            spanning_forest<int> forest;
+            double parallel_kruskal_ms = time_ms([&]()
+                                                 { forest = kruskal_spanning_forest(csr, threads); });
+            double boruvka_ms = time_ms([&]()
+                                        { forest = boruvka_spanning_forest(csr, 1); });
+            double parallel_boruvka_ms = time_ms([&]()
+                                                 { forest = boruvka_spanning_forest(csr, threads); });
+            if (forest.total_weight != kruskal.total_weight)
+            {
+                throw std::runtime_error("Spanning forest weights differ");
+            }
+
+            csv << n << ";" << p << ";" << edges.size() << ";" << kruskal.component_count() << ";"
+                << kruskal.total_weight << ";" << kruskal_ms << ";" << parallel_kruskal_ms << ";" << boruvka_ms
+                << ";" << parallel_boruvka_ms << ";" << threads << "\n";
+            std::cout << "n=" << n << ", p=" << p << ": weight=" << kruskal.total_weight
+                      << ", kruskal=" << kruskal_ms << " ms (parallel " << parallel_kruskal_ms
+                      << " ms), boruvka=" << boruvka_ms << " ms (parallel " << parallel_boruvka_ms << " ms)\n";
+        }
+    }
+
+    std::cout << "Spanning forest results saved to benchmark_spanning_forest.csv\n";
+}
+
 int main(int argc, char *argv[])
 {
     array_sequence<int> sizes = {100, 500, 1000, 2000};
     array_sequence<double> densities = {0.1, 0.3, 0.5, 0.7, 0.9};
     int runs_per_config = 5;
+    int threads = resolve_thread_count(0);
 
     if (argc > 1)
     {
@@ -54,11 +1116,12 @@ int main(int argc, char *argv[])
     std::cout << "\nDensities: ";
     for (double d : densities)
         std::cout << d << " ";
-    std::cout << "\nRuns per config: " << runs_per_config << "\n\n";
+    std::cout << "\nRuns per config: " << runs_per_config << "\n";
+    std::cout << "Parallel threads: " << threads << "\n\n";
 
     // Файл для результатов
     std::ofstream csv("benchmark.csv");
-    csv << "n;edge_density;avg_time_ms;min_time_ms;max_time_ms;components\n";
+    csv << "n;edge_density;avg_time_ms;min_time_ms;max_time_ms;components;threads;parallel_avg_time_ms;speedup\n";
 
     std::mt19937 rng(42);
 
@@ -67,6 +1130,7 @@ int main(int argc, char *argv[])
         for (double p : densities)
         {
             array_sequence<double> times;
+            double parallel_sum = 0.0;
             int comp_count = 0;
 
             for (int run = 0; run < runs_per_config; ++run)
@@ -80,6 +1144,11 @@ int main(int argc, char *argv[])
 
                 double time_ms = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
                 times.append_element(time_ms);
+
+                start = std::chrono::high_resolution_clock::now();
+                auto labels = parallel_component_labels(g, threads);
+                end = std::chrono::high_resolution_clock::now();
+                parallel_sum += std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
                 if (run == 0)
                     comp_count = components.get_length();
             }
@@ -94,23 +1163,43 @@ int main(int argc, char *argv[])
                     max_t = t;
             }
             double avg_t = sum / runs_per_config;
+            double parallel_avg_t = parallel_sum / runs_per_config;
+            double speedup = parallel_avg_t > 0.0 ? avg_t / parallel_avg_t : 0.0;
 
-            csv << n << ";" << p << ";" << avg_t << ";" << min_t << ";" << max_t << ";" << comp_count << "\n";
+            csv << n << ";" << p << ";" << avg_t << ";" << min_t << ";" << max_t << ";" << comp_count
+                << ";" << threads << ";" << parallel_avg_t << ";" << speedup << "\n";
 
             std::cout << "n=" << n << ", p=" << p
                       << "avg=" << avg_t << " ms"
                       << " (min=" << min_t << ", max=" << max_t << ")"
-                      << ", components=" << comp_count << "\n";
+                      << ", components=" << comp_count
+                      << ", parallel=" << parallel_avg_t << " ms (x" << speedup << ")\n";
         }
         std::cout << "----------------------------------------\n";
     }
 
     csv.close();
     std::cout << "\nBenchmark results saved to benchmark.csv\n";
+
     std::cout << "\nNext steps:\n";
     std::cout << "1.Open benchmark.csv in Excel/LibreOffice\n";
     std::cout << "2.Create scatter plot: X=n, Y=avg_time_ms, series=edge_density\n";
     std::cout << "3.Add trendline observe linear O(n+m) complexity\n";
 
+    run_neighbor_scan_benchmark();
+    run_construction_benchmark();
+    run_load_benchmark();
+    run_shortest_path_benchmark();
+    run_multi_source_bfs_benchmark();
+    run_biconnectivity_benchmark();
+    run_dynamic_connectivity_benchmark();
+    run_reordering_benchmark();
+    run_compression_benchmark();
+    run_hybrid_adjacency_benchmark();
+    run_triangle_benchmark(sizes, densities, threads);
+    run_component_index_benchmark(threads);
+    run_partition_benchmark();
+    run_spanning_forest_benchmark(sizes, densities, threads);
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "bench_harness.hpp"
+#include "graph_generators.hpp"
+#include "graph_builder.hpp"
+#include "graph_file.hpp"
+#include "connected_components.hpp"
+#include "parallel_connected_components.hpp"
+#include "shortest_paths.hpp"
+#include "biconnectivity.hpp"
+#include "triangles.hpp"
+#include "compressed_graph.hpp"
+#include "dot_helper.hpp"
+
+// Regression suite: every input graph goes through construction, query and
+// export phases, each case timed after warmup, and the report is written as
+// JSON.
+//
+// Usage: benchmark_suite [--scale small|medium|large] [--warmup N]
+//                        [--iterations N] [--threads N] [--filter TEXT]
+//                        [--output FILE]
+
+namespace
+{
+    struct suite_options
+    {
+        std::string scale = "small";
+        int warmup = 1;
+        int iterations = 10;
+        int threads = 0;
+        std::string filter;
+        std::string output = "benchmark_suite.json";
+    };
+
+    struct input_graph
+    {
+        std::string name;
+        int vertices;
+        std::vector<std::pair<int, int>> edges;
+    };
+
+    suite_options parse_options(int argc, char *argv[])
+    {
+        suite_options options;
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if (i + 1 >= argc)
+            {
+                throw std::invalid_argument("Missing value for " + arg);
+            }
+            std::string value = argv[++i];
+            if (arg == "--scale")
+                options.scale = value;
+            else if (arg == "--warmup")
+                options.warmup = std::stoi(value);
+            else if (arg == "--iterations")
+                options.iterations = std::stoi(value);
+            else if (arg == "--threads")
+                options.threads = std::stoi(value);
+            else if (arg == "--filter")
+                options.filter = value;
+            else if (arg == "--output")
+                options.output = value;
+            else
+                throw std::invalid_argument("Unknown option " + arg);
+        }
+        if (options.scale != "small" && options.scale != "medium" && options.scale != "large")
+        {
+            throw std::invalid_argument("Unknown scale " + options.scale);
+        }
+        return options;
+    }
+
+    // Sizes grow by about 16x per scale step.
+    std::vector<input_graph> make_inputs(const std::string &scale)
+    {
+        int step = scale == "small" ? 0 : scale == "medium" ? 1 : 2;
+        std::mt19937 rng(20240601);
+        std::vector<input_graph> inputs;
+
+        int rmat_scale = 14 + 4 * step;
+        inputs.push_back({"rmat", 1 << rmat_scale, rmat_edges(rmat_scale, 16, rng)});
+
+        int ba_n = 1 << (14 + 4 * step);
+        inputs.push_back({"barabasi_albert", ba_n, barabasi_albert_edges(ba_n, 8, rng)});
+
+        int er_n = 1 << (14 + 4 * step);
+        inputs.push_back({"erdos_renyi", er_n, erdos_renyi_edges(er_n, 16.0 / er_n, rng)});
+
+        int side = 128 << (2 * step);
+        inputs.push_back({"grid", side * side, grid_edges(side, side)});
+
+        int path_n = 1 << (16 + 4 * step);
+        inputs.push_back({"path", path_n, path_edges(path_n)});
+        return inputs;
+    }
+
+    std::string compiler_name()
+    {
+#if defined(__clang__)
+        return "clang " __clang_version__;
+#elif defined(__GNUC__)
+        return "gcc " __VERSION__;
+#else
+        return "unknown";
+#endif
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    suite_options options;
+    try
+    {
+        options = parse_options(argc, argv);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+
+    int threads = resolve_thread_count(options.threads);
+    bench_config config{options.warmup, options.iterations};
+    bench_report report;
+    report.set_context("scale", options.scale);
+    report.set_context("compiler", compiler_name());
+    report.set_context("threads", std::to_string(threads));
+    report.set_context("warmup", std::to_string(options.warmup));
+    report.set_context("iterations", std::to_string(options.iterations));
+    report.set_context("timestamp", std::to_string(static_cast<long long>(std::time(nullptr))));
+
+    std::cout << "========================================\n";
+    std::cout << "  Benchmark suite (" << options.scale << ", " << threads << " threads)\n";
+    std::cout << "========================================\n";
+
+    for (const input_graph &input : make_inputs(options.scale))
+    {
+        long long m = static_cast<long long>(input.edges.size());
+        auto run = [&](const std::string &phase, const std::string &name, auto &&body)
+        {
+            std::string full_name = phase + "/" + name + "/" + input.name;
+            if (!options.filter.empty() && full_name.find(options.filter) == std::string::npos)
+            {
+                return;
+            }
+            bench_statistics stats = measure(config, body);
+            report.add({name, phase, input.name, input.vertices, m, stats});
+            std::printf("%-48s p50=%10.3f ms  p90=%10.3f ms  p99=%10.3f ms\n", full_name.c_str(), stats.p50,
+                        stats.p90, stats.p99);
+        };
+
+        std::vector<int> payloads(input.vertices, 0);
+        build_options serial;
+        build_options parallel;
+        parallel.thread_count = threads;
+
+        // Construction
+        run("construction", "csr_serial", [&]()
+            { keep_result(build_csr_graph(payloads, input.edges, serial)); });
+        run("construction", "csr_parallel", [&]()
+            { keep_result(build_csr_graph(payloads, input.edges, parallel)); });
+        run("construction", "undirected_graph", [&]()
+            { keep_result(build_undirected_graph(payloads, input.edges, parallel)); });
+
+        auto csr = build_csr_graph(payloads, input.edges, parallel);
+        run("construction", "compressed", [&]()
+            { keep_result(compressed_graph<int>(csr)); });
+
+        // Queries
+        components_workspace components;
+        run("query", "components", [&]()
+            { keep_result(component_labels(csr, components)); });
+        run("query", "parallel_components", [&]()
+            { keep_result(parallel_component_labels(csr, threads)); });
+        bfs_workspace bfs;
+        run("query", "bfs", [&]()
+            {
+            breadth_first_search(csr, 0, bfs);
+            keep_result(bfs); });
+        biconnectivity_workspace blocks;
+        run("query", "biconnectivity", [&]()
+            { keep_result(biconnectivity(csr, blocks)); });
+        run("query", "triangles", [&]()
+            { keep_result(count_triangles(csr, threads)); });
+
+        // Export
+        run("export", "to_dot", [&]()
+            { keep_result(to_dot(csr)); });
+        // Written up front so load_graph_file does not depend on the save
+        // case passing the filter, or on files left by an earlier run.
+        std::string path = "benchmark_suite_" + input.name + ".graph";
+        save_graph_file(csr, path);
+        run("export", "save_graph_file", [&]()
+            { save_graph_file(csr, path); });
+        run("export", "load_graph_file", [&]()
+            { keep_result(load_graph_file<int>(path)); });
+        std::remove(path.c_str());
+
+        std::cout << "----------------------------------------\n";
+    }
+
+    std::ofstream json(options.output);
+    report.write_json(json);
+    std::cout << "Results saved to " << options.output << "\n";
+    return 0;
+}
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "instrumentation.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Single points of failure of an undirected graph.
+struct biconnectivity_result
+{
+    // Edges whose removal disconnects their endpoints, as (smaller, larger).
+    std::vector<std::pair<int, int>> bridges;
+    // Vertices whose removal splits their component, ascending.
+    std::vector<int> articulation_points;
+    // Biconnected components (blocks) as vertex sets: block b is
+    // block_vertices[block_offsets[b] .. block_offsets[b + 1]). An
+    // articulation point belongs to every block it joins; vertices without
+    // edges belong to none.
+    std::vector<std::size_t> block_offsets{0};
+    std::vector<int> block_vertices;
+
+    int block_count() const { return static_cast<int>(block_offsets.size()) - 1; }
+
+    std::span<const int> block(int b) const
+    {
+        return std::span<const int>(block_vertices).subspan(block_offsets[b], block_offsets[b + 1] - block_offsets[b]);
+    }
+};
+
+// DFS state kept on the heap, so depth is limited by memory rather than the
+// call stack. A frame's neighbors sit in `neighbors` right after those of
+// the frame below it, which makes the buffer a stack too.
+struct biconnectivity_workspace
+{
+    struct frame
+    {
+        int vertex;
+        bool skipped_parent;
+        std::size_t next;
+        std::size_t end;
+    };
+
+    std::vector<int> discovery;
+    std::vector<int> low;
+    std::vector<char> articulation;
+    std::vector<frame> frames;
+    std::vector<int> neighbors;
+    std::vector<int> vertex_stack;
+};
+
+// Iterative Hopcroft-Tarjan: one DFS computes discovery times and low
+// links, from which bridges, articulation points and blocks follow. Parallel
+// edges are honoured (only one edge back to the DFS parent is skipped, so a
+// doubled edge is never a bridge); self loops are ignored.
+template <typename graph>
+biconnectivity_result biconnectivity(const graph &gr, biconnectivity_workspace &workspace)
+{
+    GRAPH_PHASE("biconnectivity");
+    using frame = biconnectivity_workspace::frame;
+
+    int n = gr.vertex_count();
+    auto &discovery = workspace.discovery;
+    auto &low = workspace.low;
+    auto &articulation = workspace.articulation;
+    auto &frames = workspace.frames;
+    auto &neighbors = workspace.neighbors;
+    auto &vertex_stack = workspace.vertex_stack;
+
+    discovery.assign(n, -1);
+    low.assign(n, 0);
+    articulation.assign(n, 0);
+    frames.clear();
+    neighbors.clear();
+    vertex_stack.clear();
+
+    biconnectivity_result result;
+    int timer = 0;
+
+    auto enter = [&](int v)
+    {
+        discovery[v] = low[v] = timer++;
+        vertex_stack.push_back(v);
+        std::size_t begin = neighbors.size();
+        gr.for_each_neighbor(v, [&](int u)
+                             { neighbors.push_back(u); });
+        frames.push_back(frame{v, false, begin, neighbors.size()});
+    };
+
+    for (int root = 0; root < n; ++root)
+    {
+        if (discovery[root] != -1)
+        {
+            continue;
+        }
+
+        int root_children = 0;
+        enter(root);
+
+        while (!frames.empty())
+        {
+            frame &top = frames.back();
+            int v = top.vertex;
+            int parent = frames.size() > 1 ? frames[frames.size() - 2].vertex : -1;
+
+            if (top.next < top.end)
+            {
+                int u = neighbors[top.next++];
+                if (u == v)
+                {
+                    continue;
+                }
+                if (u == parent && !top.skipped_parent)
+                {
+                    top.skipped_parent = true;
+                    continue;
+                }
+                if (discovery[u] == -1)
+                {
+                    if (parent == -1)
+                    {
+                        ++root_children;
+                    }
+                    enter(u);
+                }
+                else
+                {
+                    low[v] = std::min(low[v], discovery[u]);
+                }
+                continue;
+            }
+
+            frames.pop_back();
+            neighbors.resize(frames.empty() ? 0 : frames.back().end);
+            if (parent == -1)
+            {
+                continue;
+            }
+
+            low[parent] = std::min(low[parent], low[v]);
+            if (low[v] > discovery[parent])
+            {
+                result.bridges.push_back({std::min(parent, v), std::max(parent, v)});
+            }
+            if (low[v] >= discovery[parent])
+            {
+                if (parent != root)
+                {
+                    articulation[parent] = 1;
+                }
+                int w;
+                do
+                {
+                    w = vertex_stack.back();
+                    vertex_stack.pop_back();
+                    result.block_vertices.push_back(w);
+                } while (w != v);
+                result.block_vertices.push_back(parent);
+                result.block_offsets.push_back(result.block_vertices.size());
+            }
+        }
+
+        if (root_children >= 2)
+        {
+            articulation[root] = 1;
+        }
+        vertex_stack.clear();
+    }
+
+    for (int v = 0; v < n; ++v)
+    {
+        if (articulation[v])
+        {
+            result.articulation_points.push_back(v);
+        }
+    }
+    return result;
+}
+
+template <typename graph>
+biconnectivity_result biconnectivity(const graph &gr)
+{
+    biconnectivity_workspace workspace;
+    return biconnectivity(gr, workspace);
+}
+
+template <typename graph>
+std::vector<std::pair<int, int>> find_bridges(const graph &gr)
+{
+    return biconnectivity(gr).bridges;
+}
+
+template <typename graph>
+std::vector<int> find_articulation_points(const graph &gr)
+{
+    return biconnectivity(gr).articulation_points;
+}
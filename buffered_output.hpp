@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <unistd.h>
+
+// Output through one large reusable buffer. Bytes reach the sink only when
+// the buffer fills up or on flush(), so writers pay a memcpy per append and
+// one sink call per buffer.
+class buffered_output
+{
+private:
+    std::vector<char> buffer;
+    std::size_t used = 0;
+    std::function<void(const char *, std::size_t)> sink;
+
+public:
+    static constexpr std::size_t default_capacity = 1 << 20;
+
+    // Writes to a file descriptor with write(2).
+    explicit buffered_output(int fd, std::size_t capacity = default_capacity)
+        : buffer(capacity), sink([fd](const char *data, std::size_t size)
+                                 {
+            while (size > 0)
+            {
+                ssize_t written = ::write(fd, data, size);
+                if (written < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    throw std::runtime_error("Cannot write output");
+                }
+                data += written;
+                size -= static_cast<std::size_t>(written);
+            } })
+    {
+    }
+
+    explicit buffered_output(std::ostream &stream, std::size_t capacity = default_capacity)
+        : buffer(capacity), sink([&stream](const char *data, std::size_t size)
+                                 {
+            stream.write(data, static_cast<std::streamsize>(size));
+            if (!stream)
+            {
+                throw std::runtime_error("Cannot write output");
+            } })
+    {
+    }
+
+    explicit buffered_output(std::string &target, std::size_t capacity = default_capacity)
+        : buffer(capacity), sink([&target](const char *data, std::size_t size)
+                                 { target.append(data, size); })
+    {
+    }
+
+    buffered_output(const buffered_output &) = delete;
+    buffered_output &operator=(const buffered_output &) = delete;
+
+    // Destructors cannot report errors, so call flush() explicitly to see them.
+    ~buffered_output()
+    {
+        try
+        {
+            flush();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    void flush()
+    {
+        if (used > 0)
+        {
+            std::size_t size = used;
+            used = 0;
+            sink(buffer.data(), size);
+        }
+    }
+
+    void append(const char *data, std::size_t size)
+    {
+        if (size > buffer.size() - used)
+        {
+            flush();
+            if (size > buffer.size())
+            {
+                sink(data, size);
+                return;
+            }
+        }
+        std::memcpy(buffer.data() + used, data, size);
+        used += size;
+    }
+
+    void append(std::string_view text)
+    {
+        append(text.data(), text.size());
+    }
+
+    void append(char c)
+    {
+        if (used == buffer.size())
+        {
+            flush();
+        }
+        buffer[used++] = c;
+    }
+
+    // Integers go through std::to_chars straight into the buffer; floating
+    // point matches std::to_string (fixed, six decimals).
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value>::type
+    append_number(T value)
+    {
+        if constexpr (std::is_same<T, bool>::value)
+        {
+            append(value ? '1' : '0');
+        }
+        else
+        {
+            constexpr std::size_t max_chars = 384;
+            if (buffer.size() - used < max_chars)
+            {
+                flush();
+            }
+            char *first = buffer.data() + used;
+            char *last = buffer.data() + std::min(buffer.size(), used + max_chars);
+            std::to_chars_result result;
+            if constexpr (std::is_floating_point<T>::value)
+            {
+                result = std::to_chars(first, last, value, std::chars_format::fixed, 6);
+            }
+            else
+            {
+                result = std::to_chars(first, last, value);
+            }
+            if (result.ec != std::errc())
+            {
+                throw std::runtime_error("Cannot format number");
+            }
+            used = static_cast<std::size_t>(result.ptr - buffer.data());
+        }
+    }
+};
@@ -0,0 +1,326 @@
+#pragma once
+
+#include "connected_components.hpp"
+#include "graph_observer.hpp"
+#include "parallel_connected_components.hpp"
+#include "undirected_graph.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Precomputed answers to "are u and v connected?" and "how big is v's
+// component?". Components are numbered as in component_labels(); members of
+// component c sit in members[offsets[c] .. offsets[c + 1]), ascending.
+//
+// The tables are immutable and shared between copies, so a copy is a cheap
+// snapshot that stays valid while a newer index is being built.
+class component_index
+{
+private:
+    struct tables
+    {
+        std::vector<int> labels;
+        std::vector<int> sizes;
+        std::vector<int> offsets;
+        std::vector<int> members;
+    };
+
+    std::shared_ptr<const tables> storage;
+
+    void check_vertex(int vertex_id) const
+    {
+        if (vertex_id < 0 || vertex_id >= vertex_count())
+        {
+            throw std::out_of_range("Invalid vertex ID");
+        }
+    }
+
+public:
+    component_index() : storage(std::make_shared<const tables>(tables{{}, {}, {0}, {}})) {}
+
+    // `labels` must number components 0 .. k - 1 with none left empty.
+    explicit component_index(std::vector<int> labels)
+    {
+        tables t;
+        int n = static_cast<int>(labels.size());
+        int k = 0;
+        for (int label : labels)
+        {
+            if (label < 0 || label >= n)
+            {
+                throw std::invalid_argument("Invalid component labels");
+            }
+            k = std::max(k, label + 1);
+        }
+
+        t.sizes.assign(k, 0);
+        for (int label : labels)
+        {
+            ++t.sizes[label];
+        }
+        t.offsets.assign(k + 1, 0);
+        for (int c = 0; c < k; ++c)
+        {
+            if (t.sizes[c] == 0)
+            {
+                throw std::invalid_argument("Invalid component labels");
+            }
+            t.offsets[c + 1] = t.offsets[c] + t.sizes[c];
+        }
+
+        // Counting sort by label; scanning vertices in order keeps each
+        // component's members ascending.
+        t.members.resize(n);
+        std::vector<int> cursor(t.offsets.begin(), t.offsets.end() - 1);
+        for (int v = 0; v < n; ++v)
+        {
+            t.members[cursor[labels[v]]++] = v;
+        }
+        t.labels = std::move(labels);
+        storage = std::make_shared<const tables>(std::move(t));
+    }
+
+    // Labels come from parallel_component_labels when threads != 1, which
+    // needs a symmetric graph, and from the sequential traversal otherwise.
+    template <typename graph>
+    static component_index build(const graph &gr, int threads = 1)
+    {
+        if (threads == 1)
+        {
+            return component_index(component_labels(gr));
+        }
+        return component_index(parallel_component_labels(gr, threads));
+    }
+
+    int vertex_count() const { return static_cast<int>(storage->labels.size()); }
+    int component_count() const { return static_cast<int>(storage->sizes.size()); }
+
+    int component_of(int vertex_id) const
+    {
+        check_vertex(vertex_id);
+        return storage->labels[vertex_id];
+    }
+
+    int component_size(int vertex_id) const
+    {
+        check_vertex(vertex_id);
+        return storage->sizes[storage->labels[vertex_id]];
+    }
+
+    bool connected(int u, int v) const
+    {
+        check_vertex(u);
+        check_vertex(v);
+        return storage->labels[u] == storage->labels[v];
+    }
+
+    std::span<const int> members(int component) const
+    {
+        if (component < 0 || component >= component_count())
+        {
+            throw std::out_of_range("Invalid component ID");
+        }
+        const tables &t = *storage;
+        return std::span<const int>(t.members).subspan(t.offsets[component], t.sizes[component]);
+    }
+
+    std::span<const int> label_array() const { return storage->labels; }
+    std::span<const int> size_array() const { return storage->sizes; }
+    std::span<const int> offset_array() const { return storage->offsets; }
+    std::span<const int> member_array() const { return storage->members; }
+
+    // answers[i] = 1 when queries[i] is a connected pair. Every id is checked
+    // before its label is read.
+    void connected_batch(std::span<const std::pair<int, int>> queries, std::span<char> answers) const
+    {
+        if (answers.size() != queries.size())
+        {
+            throw std::invalid_argument("Output size does not match query count");
+        }
+        const int *labels = storage->labels.data();
+        const int n = vertex_count();
+        static_assert(sizeof(std::pair<int, int>) == 2 * sizeof(int));
+        const int *ids = reinterpret_cast<const int *>(queries.data());
+        std::size_t count = queries.size();
+        std::size_t i = 0;
+
+#if defined(__AVX2__)
+        // Four pairs per step: gather eight labels, swap neighboring lanes
+        // and compare, so the even lanes hold the answers.
+        const __m256i below = _mm256_set1_epi32(-1);
+        const __m256i above = _mm256_set1_epi32(n);
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256i pair_ids = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ids + 2 * i));
+            __m256i valid = _mm256_and_si256(_mm256_cmpgt_epi32(pair_ids, below), _mm256_cmpgt_epi32(above, pair_ids));
+            if (_mm256_movemask_epi8(valid) != -1)
+            {
+                throw std::out_of_range("Invalid vertex ID");
+            }
+            __m256i pair_labels = _mm256_i32gather_epi32(labels, pair_ids, 4);
+            __m256i swapped = _mm256_shuffle_epi32(pair_labels, _MM_SHUFFLE(2, 3, 0, 1));
+            int equal = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(pair_labels, swapped)));
+            answers[i] = equal & 1;
+            answers[i + 1] = (equal >> 2) & 1;
+            answers[i + 2] = (equal >> 4) & 1;
+            answers[i + 3] = (equal >> 6) & 1;
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            int u = ids[2 * i];
+            int v = ids[2 * i + 1];
+            if (static_cast<unsigned>(u) >= static_cast<unsigned>(n) ||
+                static_cast<unsigned>(v) >= static_cast<unsigned>(n))
+            {
+                throw std::out_of_range("Invalid vertex ID");
+            }
+            answers[i] = labels[u] == labels[v];
+        }
+    }
+
+    std::vector<char> connected_batch(std::span<const std::pair<int, int>> queries) const
+    {
+        std::vector<char> answers(queries.size());
+        connected_batch(queries, answers);
+        return answers;
+    }
+
+    // sizes[i] = size of the component of vertices[i].
+    void component_size_batch(std::span<const int> vertices, std::span<int> sizes) const
+    {
+        if (sizes.size() != vertices.size())
+        {
+            throw std::invalid_argument("Output size does not match query count");
+        }
+        const int *labels = storage->labels.data();
+        const int *component_sizes = storage->sizes.data();
+        const int n = vertex_count();
+        std::size_t count = vertices.size();
+        std::size_t i = 0;
+
+#if defined(__AVX2__)
+        const __m256i below = _mm256_set1_epi32(-1);
+        const __m256i above = _mm256_set1_epi32(n);
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i ids = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(vertices.data() + i));
+            __m256i valid = _mm256_and_si256(_mm256_cmpgt_epi32(ids, below), _mm256_cmpgt_epi32(above, ids));
+            if (_mm256_movemask_epi8(valid) != -1)
+            {
+                throw std::out_of_range("Invalid vertex ID");
+            }
+            __m256i vertex_labels = _mm256_i32gather_epi32(labels, ids, 4);
+            __m256i result = _mm256_i32gather_epi32(component_sizes, vertex_labels, 4);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(sizes.data() + i), result);
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            int v = vertices[i];
+            if (static_cast<unsigned>(v) >= static_cast<unsigned>(n))
+            {
+                throw std::out_of_range("Invalid vertex ID");
+            }
+            sizes[i] = component_sizes[labels[v]];
+        }
+    }
+
+    std::vector<int> component_size_batch(std::span<const int> vertices) const
+    {
+        std::vector<int> sizes(vertices.size());
+        component_size_batch(vertices, sizes);
+        return sizes;
+    }
+};
+
+// A component_index kept in step with an undirected_graph. Adding a vertex
+// or replacing a generator marks the index stale; the next snapshot()
+// rebuilds it. Readers hold on to their snapshot, so a rebuild never pulls
+// tables out from under a batch in flight.
+//
+// snapshot() may be called from many threads at once. Graph mutations still
+// need the same external synchronization as the graph itself.
+template <typename t_vertex, typename t_edge = std::monostate>
+class tracked_component_index : public graph_observer
+{
+private:
+    undirected_graph<t_vertex, t_edge> *graph;
+    int threads;
+    mutable std::mutex mutex;
+    mutable component_index index;
+    mutable bool stale = true;
+    mutable std::size_t rebuilds = 0;
+
+public:
+    // threads != 1 labels with parallel_component_labels, which requires
+    // every generator to report symmetric adjacency.
+    explicit tracked_component_index(undirected_graph<t_vertex, t_edge> &source, int thread_count = 1)
+        : graph(&source), threads(thread_count)
+    {
+        graph->attach_observer(this);
+    }
+
+    tracked_component_index(const tracked_component_index &) = delete;
+    tracked_component_index &operator=(const tracked_component_index &) = delete;
+
+    ~tracked_component_index() override
+    {
+        graph->detach_observer(this);
+    }
+
+    void on_vertex_added(int) override
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stale = true;
+    }
+
+    void on_edges_changed(int) override
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stale = true;
+    }
+
+    // For generators whose output depends on state outside the graph.
+    void invalidate()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stale = true;
+    }
+
+    bool is_stale() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stale;
+    }
+
+    // Number of times the index has been built.
+    std::size_t rebuild_count() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return rebuilds;
+    }
+
+    component_index snapshot() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stale)
+        {
+            index = component_index::build(*graph, threads);
+            stale = false;
+            ++rebuilds;
+        }
+        return index;
+    }
+};
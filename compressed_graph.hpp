@@ -0,0 +1,74 @@
+#pragma once
+
+#include "csr_graph.hpp"
+#include "undirected_graph.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Immutable adjacency snapshot with gap-encoded neighbor lists. Each list
+// is sorted and stored as LEB128 varints: the degree, the first neighbor as
+// a zigzag-encoded difference from the vertex itself, then the gaps between
+// consecutive neighbors. Labels that are close together (see
+// vertex_reordering.hpp) give gaps that fit in one byte.
+//
+// Lists are decoded on the fly by for_each_neighbor, so generic algorithms
+// and writers (connected_components, to_dot) run on it unchanged. Neighbors
+// come out in ascending order, and parallel edges are kept as zero gaps.
+// Copies share the encoded storage, as with csr_graph.
+template <typename t_vertex>
+class compressed_graph
+{
+private:
+    struct encoded_arrays
+    {
+        std::vector<t_vertex> payloads;
+        std::vector<std::size_t> offsets;
+        std::vector<std::uint8_t> bytes;
+        std::size_t arcs = 0;
+    };
+
+    std::shared_ptr<const encoded_arrays> storage;
+
+    static void append_varint(std::vector<std::uint8_t> &bytes, std::uint64_t value);
+    static std::uint64_t read_varint(const std::uint8_t *&cursor);
+
+    void check_vertex(int vertex_id) const;
+
+    template <typename neighbor_source>
+    void encode(int n, neighbor_source &&source, std::vector<t_vertex> vertex_payloads);
+
+public:
+    using edge_type = std::monostate;
+
+    compressed_graph();
+    explicit compressed_graph(const csr_graph<t_vertex> &graph);
+    explicit compressed_graph(const undirected_graph<t_vertex> &graph);
+
+    static compressed_graph from_edge_list(std::vector<t_vertex> vertex_payloads,
+                                           const std::vector<std::pair<int, int>> &edges);
+
+    int vertex_count() const;
+    std::size_t arc_count() const;
+    int degree(int vertex_id) const;
+
+    template <typename visitor>
+    void for_each_neighbor(int vertex_id, visitor &&visit) const;
+
+    // Replaces `out` with the vertex's neighbors.
+    void decode_neighbors(int vertex_id, std::vector<int> &out) const;
+
+    const t_vertex &vertex_data(int vertex_id) const;
+
+    // Size of the encoded lists and their offsets, without payloads.
+    std::size_t adjacency_bytes() const;
+    double bytes_per_arc() const;
+
+    array_sequence<list_sequence<int>> find_connected_components() const;
+    std::vector<int> find_component_labels() const;
+};
+
+#include "compressed_graph.tpp"
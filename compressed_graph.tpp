@@ -0,0 +1,206 @@
+#include "compressed_graph.hpp"
+#include "connected_components.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+template <typename t_vertex>
+void compressed_graph<t_vertex>::append_varint(std::vector<std::uint8_t> &bytes, std::uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        bytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<std::uint8_t>(value));
+}
+
+template <typename t_vertex>
+std::uint64_t compressed_graph<t_vertex>::read_varint(const std::uint8_t *&cursor)
+{
+    // Most gaps fit in one byte.
+    std::uint64_t value = *cursor++;
+    if (value < 0x80)
+    {
+        return value;
+    }
+    value &= 0x7f;
+    int shift = 7;
+    while (true)
+    {
+        std::uint64_t byte = *cursor++;
+        value |= (byte & 0x7f) << shift;
+        if (byte < 0x80)
+        {
+            return value;
+        }
+        shift += 7;
+    }
+}
+
+template <typename t_vertex>
+void compressed_graph<t_vertex>::check_vertex(int vertex_id) const
+{
+    if (vertex_id < 0 || vertex_id >= vertex_count())
+    {
+        throw std::out_of_range("Invalid vertex ID");
+    }
+}
+
+// `source(v, list)` fills `list` with the neighbors of v.
+template <typename t_vertex>
+template <typename neighbor_source>
+void compressed_graph<t_vertex>::encode(int n, neighbor_source &&source, std::vector<t_vertex> vertex_payloads)
+{
+    auto arrays = std::make_shared<encoded_arrays>();
+    arrays->payloads = std::move(vertex_payloads);
+    arrays->offsets.reserve(n + 1);
+    arrays->offsets.push_back(0);
+
+    std::vector<int> list;
+    for (int v = 0; v < n; ++v)
+    {
+        list.clear();
+        source(v, list);
+        std::sort(list.begin(), list.end());
+        append_varint(arrays->bytes, list.size());
+        std::int64_t previous = v;
+        for (std::size_t i = 0; i < list.size(); ++i)
+        {
+            if (list[i] < 0 || list[i] >= n)
+            {
+                throw std::out_of_range("Invalid vertex ID");
+            }
+            std::int64_t gap = list[i] - previous;
+            // The first gap may be negative; the rest never are.
+            std::uint64_t code = i == 0 ? (static_cast<std::uint64_t>(gap) << 1) ^ static_cast<std::uint64_t>(gap >> 63)
+                                        : static_cast<std::uint64_t>(gap);
+            append_varint(arrays->bytes, code);
+            previous = list[i];
+        }
+        arrays->arcs += list.size();
+        arrays->offsets.push_back(arrays->bytes.size());
+    }
+    arrays->bytes.shrink_to_fit();
+    storage = std::move(arrays);
+}
+
+template <typename t_vertex>
+compressed_graph<t_vertex>::compressed_graph()
+    : storage(std::make_shared<encoded_arrays>(encoded_arrays{{}, {0}, {}, 0}))
+{
+}
+
+template <typename t_vertex>
+compressed_graph<t_vertex>::compressed_graph(const csr_graph<t_vertex> &graph)
+{
+    std::span<const t_vertex> payloads = graph.payload_array();
+    encode(graph.vertex_count(), [&](int v, std::vector<int> &list)
+           {
+        std::span<const int> neighbors = graph.neighbors(v);
+        list.assign(neighbors.begin(), neighbors.end()); },
+           std::vector<t_vertex>(payloads.begin(), payloads.end()));
+}
+
+template <typename t_vertex>
+compressed_graph<t_vertex>::compressed_graph(const undirected_graph<t_vertex> &graph)
+{
+    int n = graph.vertex_count();
+    std::vector<t_vertex> payloads;
+    payloads.reserve(n);
+    for (int v = 0; v < n; ++v)
+    {
+        payloads.push_back(graph.vertex_data(v));
+    }
+    encode(n, [&](int v, std::vector<int> &list)
+           { graph.for_each_neighbor(v, [&](int u)
+                                     { list.push_back(u); }); },
+           std::move(payloads));
+}
+
+// Goes through a CSR snapshot, so the uncompressed arcs exist briefly.
+template <typename t_vertex>
+compressed_graph<t_vertex> compressed_graph<t_vertex>::from_edge_list(std::vector<t_vertex> vertex_payloads,
+                                                                      const std::vector<std::pair<int, int>> &edges)
+{
+    return compressed_graph(csr_graph<t_vertex>::from_edge_list(std::move(vertex_payloads), edges));
+}
+
+template <typename t_vertex>
+int compressed_graph<t_vertex>::vertex_count() const
+{
+    return static_cast<int>(storage->payloads.size());
+}
+
+template <typename t_vertex>
+std::size_t compressed_graph<t_vertex>::arc_count() const
+{
+    return storage->arcs;
+}
+
+template <typename t_vertex>
+int compressed_graph<t_vertex>::degree(int vertex_id) const
+{
+    check_vertex(vertex_id);
+    const std::uint8_t *cursor = storage->bytes.data() + storage->offsets[vertex_id];
+    return static_cast<int>(read_varint(cursor));
+}
+
+template <typename t_vertex>
+template <typename visitor>
+void compressed_graph<t_vertex>::for_each_neighbor(int vertex_id, visitor &&visit) const
+{
+    check_vertex(vertex_id);
+    const std::uint8_t *cursor = storage->bytes.data() + storage->offsets[vertex_id];
+    std::uint64_t remaining = read_varint(cursor);
+    if (remaining == 0)
+    {
+        return;
+    }
+    std::uint64_t code = read_varint(cursor);
+    std::int64_t current = vertex_id + (static_cast<std::int64_t>(code >> 1) ^ -static_cast<std::int64_t>(code & 1));
+    visit(static_cast<int>(current));
+    while (--remaining > 0)
+    {
+        current += static_cast<std::int64_t>(read_varint(cursor));
+        visit(static_cast<int>(current));
+    }
+}
+
+template <typename t_vertex>
+void compressed_graph<t_vertex>::decode_neighbors(int vertex_id, std::vector<int> &out) const
+{
+    out.clear();
+    for_each_neighbor(vertex_id, [&](int u)
+                      { out.push_back(u); });
+}
+
+template <typename t_vertex>
+const t_vertex &compressed_graph<t_vertex>::vertex_data(int vertex_id) const
+{
+    check_vertex(vertex_id);
+    return storage->payloads[vertex_id];
+}
+
+template <typename t_vertex>
+std::size_t compressed_graph<t_vertex>::adjacency_bytes() const
+{
+    return storage->bytes.size() + storage->offsets.size() * sizeof(std::size_t);
+}
+
+template <typename t_vertex>
+double compressed_graph<t_vertex>::bytes_per_arc() const
+{
+    return arc_count() == 0 ? 0.0 : static_cast<double>(adjacency_bytes()) / arc_count();
+}
+
+template <typename t_vertex>
+array_sequence<list_sequence<int>> compressed_graph<t_vertex>::find_connected_components() const
+{
+    return connected_components(*this);
+}
+
+template <typename t_vertex>
+std::vector<int> compressed_graph<t_vertex>::find_component_labels() const
+{
+    return component_labels(*this);
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+// Lock-free disjoint-set forest with union by rank and path halving.
+// Each node is one 64-bit word holding (rank << 32) | parent, so a root can
+// be hooked with a single CAS that also checks its rank has not changed.
+// find, unite and same_set may run concurrently from any number of threads;
+// grow must not overlap with any other call.
+class concurrent_disjoint_set
+{
+private:
+    std::unique_ptr<std::atomic<std::uint64_t>[]> nodes;
+    int count = 0;
+
+    static std::uint64_t pack(int parent, std::uint32_t rank)
+    {
+        return (static_cast<std::uint64_t>(rank) << 32) | static_cast<std::uint32_t>(parent);
+    }
+
+    static int parent_of(std::uint64_t node) { return static_cast<int>(static_cast<std::uint32_t>(node)); }
+    static std::uint32_t rank_of(std::uint64_t node) { return static_cast<std::uint32_t>(node >> 32); }
+
+    void check(int element) const
+    {
+        if (element < 0 || element >= count)
+        {
+            throw std::out_of_range("Invalid vertex ID");
+        }
+    }
+
+    int find_root(int element) const
+    {
+        while (true)
+        {
+            std::uint64_t node = nodes[element].load(std::memory_order_acquire);
+            int parent = parent_of(node);
+            if (parent == element)
+            {
+                return element;
+            }
+
+            std::uint64_t parent_node = nodes[parent].load(std::memory_order_acquire);
+            int grandparent = parent_of(parent_node);
+            if (grandparent != parent)
+            {
+                // Path halving: only a non-root changes here, and only to one
+                // of its ancestors, so losing the race is harmless.
+                nodes[element].compare_exchange_weak(node, pack(grandparent, rank_of(node)),
+                                                     std::memory_order_release, std::memory_order_relaxed);
+            }
+            element = grandparent;
+        }
+    }
+
+public:
+    concurrent_disjoint_set() = default;
+    explicit concurrent_disjoint_set(int element_count) { grow(element_count); }
+
+    int size() const { return count; }
+
+    // Adds singleton sets until size() == element_count. Not thread-safe.
+    void grow(int element_count)
+    {
+        if (element_count <= count)
+        {
+            return;
+        }
+
+        std::unique_ptr<std::atomic<std::uint64_t>[]> grown(new std::atomic<std::uint64_t>[element_count]);
+        for (int i = 0; i < count; ++i)
+        {
+            grown[i].store(nodes[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        for (int i = count; i < element_count; ++i)
+        {
+            grown[i].store(pack(i, 0), std::memory_order_relaxed);
+        }
+        nodes = std::move(grown);
+        count = element_count;
+    }
+
+    int find(int element) const
+    {
+        check(element);
+        return find_root(element);
+    }
+
+    // Returns true when the call merged two different sets.
+    bool unite(int a, int b)
+    {
+        check(a);
+        check(b);
+
+        while (true)
+        {
+            int root_a = find_root(a);
+            int root_b = find_root(b);
+            if (root_a == root_b)
+            {
+                return false;
+            }
+
+            std::uint64_t node_a = nodes[root_a].load(std::memory_order_acquire);
+            std::uint64_t node_b = nodes[root_b].load(std::memory_order_acquire);
+            std::uint32_t rank_a = rank_of(node_a);
+            std::uint32_t rank_b = rank_of(node_b);
+
+            // Hook the root with the smaller (rank, id) key. Keys strictly
+            // increase towards the root, which rules out cycles.
+            if (rank_a > rank_b || (rank_a == rank_b && root_a > root_b))
+            {
+                std::swap(root_a, root_b);
+                std::swap(node_a, node_b);
+                std::swap(rank_a, rank_b);
+            }
+
+            if (parent_of(node_a) != root_a)
+            {
+                continue;
+            }
+            if (!nodes[root_a].compare_exchange_strong(node_a, pack(root_b, rank_a), std::memory_order_acq_rel))
+            {
+                continue;
+            }
+
+            if (rank_a == rank_b)
+            {
+                std::uint64_t expected = pack(root_b, rank_b);
+                nodes[root_b].compare_exchange_strong(expected, pack(root_b, rank_b + 1), std::memory_order_acq_rel);
+            }
+            return true;
+        }
+    }
+
+    // Linearizable connectivity check: if the roots differ, re-reading the
+    // first root confirms it was still a root while the second was found.
+    bool same_set(int a, int b) const
+    {
+        check(a);
+        check(b);
+
+        while (true)
+        {
+            int root_a = find_root(a);
+            int root_b = find_root(b);
+            if (root_a == root_b)
+            {
+                return true;
+            }
+            if (parent_of(nodes[root_a].load(std::memory_order_acquire)) == root_a)
+            {
+                return false;
+            }
+        }
+    }
+};
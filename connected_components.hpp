@@ -0,0 +1,112 @@
+#pragma once
+
+#include "lab3_2ndsem/headers/list_sequence.hpp"
+#include "lab3_2ndsem/headers/array_sequence.hpp"
+#include "dynamic_bitset.hpp"
+#include "instrumentation.hpp"
+#include <memory_resource>
+#include <vector>
+
+// Scratch state for the traversal. Passing the same workspace to repeated
+// calls reuses its storage instead of reallocating it; building it on an
+// arena lets a single call release all of its scratch at once.
+struct components_workspace
+{
+    dynamic_bitset visited;
+    std::pmr::vector<int> stack;
+
+    components_workspace() = default;
+    explicit components_workspace(std::pmr::memory_resource *resource) : visited(resource), stack(resource) {}
+};
+
+// Iterative DFS from `root` that marks vertices on push, so the work stack
+// never holds more than vertex_count() entries.
+template <typename graph, typename visitor>
+void visit_component(const graph &gr, int root, components_workspace &workspace, visitor &&visit)
+{
+    auto &visited = workspace.visited;
+    auto &stack = workspace.stack;
+
+    visited.set(root);
+    stack.push_back(root);
+
+    while (!stack.empty())
+    {
+        int v = stack.back();
+        stack.pop_back();
+        GRAPH_COUNT(vertices_visited, 1);
+        visit(v);
+
+        gr.for_each_neighbor(v, [&](int u)
+                             {
+            if (!visited.test_and_set(u))
+            {
+                stack.push_back(u);
+            } });
+    }
+}
+
+// Works on any graph exposing vertex_count() and for_each_neighbor(v, f).
+template <typename graph>
+array_sequence<list_sequence<int>> connected_components(const graph &gr, components_workspace &workspace)
+{
+    GRAPH_PHASE("connected_components");
+    int n = gr.vertex_count();
+    workspace.visited.assign(n);
+    workspace.stack.clear();
+
+    array_sequence<list_sequence<int>> components;
+
+    for (int v = 0; v < n; ++v)
+    {
+        if (!workspace.visited.test(v))
+        {
+            list_sequence<int> component;
+            visit_component(gr, v, workspace, [&](int u)
+                            { component.append_element(u); });
+            components.append_element(std::move(component));
+        }
+    }
+
+    return components;
+}
+
+template <typename graph>
+array_sequence<list_sequence<int>> connected_components(const graph &gr)
+{
+    components_workspace workspace;
+    return connected_components(gr, workspace);
+}
+
+// Flat vertex -> component id mapping. Components are numbered in order of
+// their smallest vertex, matching the order of connected_components().
+template <typename graph>
+std::vector<int> component_labels(const graph &gr, components_workspace &workspace)
+{
+    GRAPH_PHASE("component_labels");
+    int n = gr.vertex_count();
+    workspace.visited.assign(n);
+    workspace.stack.clear();
+
+    std::vector<int> labels(n, -1);
+    int next_label = 0;
+
+    for (int v = 0; v < n; ++v)
+    {
+        if (!workspace.visited.test(v))
+        {
+            visit_component(gr, v, workspace, [&](int u)
+                            { labels[u] = next_label; });
+            ++next_label;
+        }
+    }
+
+    return labels;
+}
+
+template <typename graph>
+std::vector<int> component_labels(const graph &gr)
+{
+    components_workspace workspace;
+    return component_labels(gr, workspace);
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "undirected_graph.hpp"
+#include "edge.hpp"
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <span>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// Immutable compressed sparse row snapshot: the neighbors of vertex v are
+// targets[offsets[v] .. offsets[v + 1]).
+//
+// The arrays are read through spans into storage kept alive by a shared
+// owner: either vectors built in memory or a memory-mapped file. Since the
+// snapshot never changes, copies share that storage.
+//
+// Weighted graphs keep weights[i] for the arc targets[i] in a parallel array.
+// With t_edge = std::monostate that array and its member are left out.
+template <typename t_vertex, typename t_edge = std::monostate>
+class csr_graph
+{
+private:
+    struct owned_arrays
+    {
+        std::vector<t_vertex> payloads;
+        std::vector<std::size_t> offsets;
+        std::vector<int> targets;
+        std::vector<t_edge> weights;
+    };
+
+    std::shared_ptr<const void> storage;
+    std::span<const t_vertex> payloads;
+    std::span<const std::size_t> offsets;
+    std::span<const int> targets;
+    [[no_unique_address]] edge_weight_span<t_edge> weights;
+
+    void adopt(std::vector<t_vertex> vertex_payloads, std::vector<std::size_t> offset_array,
+               std::vector<int> target_array, std::vector<t_edge> weight_array = {});
+    void validate() const;
+
+    template <typename edge_list>
+    static csr_graph symmetric_from(std::vector<t_vertex> vertex_payloads, const edge_list &edges);
+
+public:
+    using edge_type = t_edge;
+
+    csr_graph() = default;
+    explicit csr_graph(const undirected_graph<t_vertex, t_edge> &graph);
+    csr_graph(std::vector<t_vertex> vertex_payloads, std::vector<std::size_t> offset_array,
+              std::vector<int> target_array);
+    csr_graph(std::vector<t_vertex> vertex_payloads, std::vector<std::size_t> offset_array,
+              std::vector<int> target_array, std::vector<t_edge> weight_array)
+        requires is_weighted_v<t_edge>;
+    csr_graph(std::shared_ptr<const void> owner, std::span<const t_vertex> vertex_payloads,
+              std::span<const std::size_t> offset_array, std::span<const int> target_array,
+              std::span<const t_edge> weight_array = {});
+
+    static csr_graph from_edge_list(std::vector<t_vertex> vertex_payloads,
+                                    const std::vector<std::pair<int, int>> &edges);
+    static csr_graph from_weighted_edge_list(std::vector<t_vertex> vertex_payloads,
+                                             const std::vector<std::tuple<int, int, t_edge>> &edges)
+        requires is_weighted_v<t_edge>;
+
+    int vertex_count() const;
+    std::size_t arc_count() const;
+    int degree(int vertex_id) const;
+
+    std::span<const int> neighbors(int vertex_id) const;
+
+    edge_range<t_edge> edges(int vertex_id) const;
+
+    template <typename visitor>
+    void for_each_neighbor(int vertex_id, visitor &&visit) const;
+
+    // visit(target, weight) for every arc of the vertex.
+    template <typename visitor>
+    void for_each_edge(int vertex_id, visitor &&visit) const;
+
+    const t_vertex &vertex_data(int vertex_id) const;
+
+    std::span<const t_vertex> payload_array() const;
+    std::span<const std::size_t> offset_array() const;
+    std::span<const int> target_array() const;
+    std::span<const t_edge> weight_array() const
+        requires is_weighted_v<t_edge>;
+
+    array_sequence<list_sequence<int>> find_connected_components() const;
+    std::vector<int> find_component_labels() const;
+};
+
+#include "csr_graph.tpp"
@@ -0,0 +1,295 @@
+#include "csr_graph.hpp"
+#include "connected_components.hpp"
+#include "instrumentation.hpp"
+#include <stdexcept>
+
+template <typename t_vertex, typename t_edge>
+void csr_graph<t_vertex, t_edge>::adopt(std::vector<t_vertex> vertex_payloads, std::vector<std::size_t> offset_array,
+                                        std::vector<int> target_array, std::vector<t_edge> weight_array)
+{
+    auto arrays = std::make_shared<owned_arrays>();
+    arrays->payloads = std::move(vertex_payloads);
+    arrays->offsets = std::move(offset_array);
+    arrays->targets = std::move(target_array);
+    arrays->weights = std::move(weight_array);
+
+    payloads = arrays->payloads;
+    offsets = arrays->offsets;
+    targets = arrays->targets;
+    weights = std::span<const t_edge>(arrays->weights);
+    storage = std::move(arrays);
+}
+
+template <typename t_vertex, typename t_edge>
+void csr_graph<t_vertex, t_edge>::validate() const
+{
+    int n = vertex_count();
+    if (offsets.size() != payloads.size() + 1 || offsets.front() != 0 || offsets.back() != targets.size())
+    {
+        throw std::invalid_argument("Invalid CSR offsets");
+    }
+    for (int v = 0; v < n; ++v)
+    {
+        if (offsets[v] > offsets[v + 1])
+        {
+            throw std::invalid_argument("Invalid CSR offsets");
+        }
+    }
+    for (int u : targets)
+    {
+        if (u < 0 || u >= n)
+        {
+            throw std::out_of_range("Invalid vertex ID");
+        }
+    }
+    if constexpr (is_weighted_v<t_edge>)
+    {
+        if (weights.size() != targets.size())
+        {
+            throw std::invalid_argument("Invalid CSR weights");
+        }
+    }
+}
+
+template <typename t_vertex, typename t_edge>
+csr_graph<t_vertex, t_edge>::csr_graph(const undirected_graph<t_vertex, t_edge> &graph)
+{
+    int n = graph.vertex_count();
+    std::vector<t_vertex> vertex_payloads;
+    std::vector<std::size_t> offset_array;
+    std::vector<int> target_array;
+    std::vector<t_edge> weight_array;
+    vertex_payloads.reserve(n);
+    offset_array.reserve(n + 1);
+    offset_array.push_back(0);
+
+    for (int v = 0; v < n; ++v)
+    {
+        vertex_payloads.push_back(graph.vertex_data(v));
+        graph.for_each_edge(v, [&](int u, const t_edge &weight)
+                            {
+            if (u < 0 || u >= n)
+            {
+                throw std::out_of_range("Invalid vertex ID");
+            }
+            target_array.push_back(u);
+            if constexpr (is_weighted_v<t_edge>)
+            {
+                weight_array.push_back(weight);
+            } });
+        offset_array.push_back(target_array.size());
+    }
+
+    adopt(std::move(vertex_payloads), std::move(offset_array), std::move(target_array), std::move(weight_array));
+}
+
+// Adopts prebuilt arrays after checking that they describe a valid CSR.
+template <typename t_vertex, typename t_edge>
+csr_graph<t_vertex, t_edge>::csr_graph(std::vector<t_vertex> vertex_payloads, std::vector<std::size_t> offset_array,
+                                       std::vector<int> target_array)
+{
+    adopt(std::move(vertex_payloads), std::move(offset_array), std::move(target_array));
+    validate();
+}
+
+template <typename t_vertex, typename t_edge>
+csr_graph<t_vertex, t_edge>::csr_graph(std::vector<t_vertex> vertex_payloads, std::vector<std::size_t> offset_array,
+                                       std::vector<int> target_array, std::vector<t_edge> weight_array)
+    requires is_weighted_v<t_edge>
+{
+    adopt(std::move(vertex_payloads), std::move(offset_array), std::move(target_array), std::move(weight_array));
+    validate();
+}
+
+// Views external arrays without copying or validating them; `owner` keeps
+// the memory behind the spans alive.
+template <typename t_vertex, typename t_edge>
+csr_graph<t_vertex, t_edge>::csr_graph(std::shared_ptr<const void> owner, std::span<const t_vertex> vertex_payloads,
+                                       std::span<const std::size_t> offset_array, std::span<const int> target_array,
+                                       std::span<const t_edge> weight_array)
+    : storage(std::move(owner)), payloads(vertex_payloads), offsets(offset_array), targets(target_array),
+      weights(weight_array)
+{
+}
+
+template <typename t_vertex, typename t_edge>
+csr_graph<t_vertex, t_edge> csr_graph<t_vertex, t_edge>::from_edge_list(std::vector<t_vertex> vertex_payloads,
+                                                                        const std::vector<std::pair<int, int>> &edges)
+{
+    return symmetric_from(std::move(vertex_payloads), edges);
+}
+
+// Both arcs of an edge carry its weight.
+template <typename t_vertex, typename t_edge>
+csr_graph<t_vertex, t_edge> csr_graph<t_vertex, t_edge>::from_weighted_edge_list(
+    std::vector<t_vertex> vertex_payloads, const std::vector<std::tuple<int, int, t_edge>> &edges)
+    requires is_weighted_v<t_edge>
+{
+    return symmetric_from(std::move(vertex_payloads), edges);
+}
+
+// Elements of `edges` are pairs or (u, v, weight) tuples. Pairs give
+// weighted graphs default-constructed weights.
+template <typename t_vertex, typename t_edge>
+template <typename edge_list>
+csr_graph<t_vertex, t_edge> csr_graph<t_vertex, t_edge>::symmetric_from(std::vector<t_vertex> vertex_payloads,
+                                                                        const edge_list &edges)
+{
+    int n = static_cast<int>(vertex_payloads.size());
+    std::vector<std::size_t> offset_array(n + 1, 0);
+
+    for (const auto &e : edges)
+    {
+        int u = std::get<0>(e);
+        int v = std::get<1>(e);
+        if (u < 0 || u >= n || v < 0 || v >= n)
+        {
+            throw std::out_of_range("Invalid vertex ID");
+        }
+        ++offset_array[u + 1];
+        if (u != v)
+        {
+            ++offset_array[v + 1];
+        }
+    }
+
+    for (int v = 0; v < n; ++v)
+    {
+        offset_array[v + 1] += offset_array[v];
+    }
+
+    std::vector<int> target_array(offset_array[n]);
+    std::vector<t_edge> weight_array(is_weighted_v<t_edge> ? offset_array[n] : 0);
+    std::vector<std::size_t> cursor(offset_array.begin(), offset_array.end() - 1);
+    for (const auto &e : edges)
+    {
+        int u = std::get<0>(e);
+        int v = std::get<1>(e);
+        if constexpr (is_weighted_v<t_edge> && std::tuple_size_v<std::decay_t<decltype(e)>> == 3)
+        {
+            weight_array[cursor[u]] = std::get<2>(e);
+            if (u != v)
+            {
+                weight_array[cursor[v]] = std::get<2>(e);
+            }
+        }
+        target_array[cursor[u]++] = v;
+        if (u != v)
+        {
+            target_array[cursor[v]++] = u;
+        }
+    }
+
+    csr_graph result;
+    result.adopt(std::move(vertex_payloads), std::move(offset_array), std::move(target_array), std::move(weight_array));
+    return result;
+}
+
+template <typename t_vertex, typename t_edge>
+int csr_graph<t_vertex, t_edge>::vertex_count() const
+{
+    return static_cast<int>(payloads.size());
+}
+
+template <typename t_vertex, typename t_edge>
+std::size_t csr_graph<t_vertex, t_edge>::arc_count() const
+{
+    return targets.size();
+}
+
+template <typename t_vertex, typename t_edge>
+int csr_graph<t_vertex, t_edge>::degree(int vertex_id) const
+{
+    return static_cast<int>(neighbors(vertex_id).size());
+}
+
+template <typename t_vertex, typename t_edge>
+std::span<const int> csr_graph<t_vertex, t_edge>::neighbors(int vertex_id) const
+{
+    if (vertex_id < 0 || vertex_id >= vertex_count())
+    {
+        throw std::out_of_range("Invalid vertex ID");
+    }
+    return targets.subspan(offsets[vertex_id], offsets[vertex_id + 1] - offsets[vertex_id]);
+}
+
+template <typename t_vertex, typename t_edge>
+edge_range<t_edge> csr_graph<t_vertex, t_edge>::edges(int vertex_id) const
+{
+    std::span<const int> vertex_targets = neighbors(vertex_id);
+    return edge_range<t_edge>(vertex_targets, weights.subspan(offsets[vertex_id], vertex_targets.size()));
+}
+
+template <typename t_vertex, typename t_edge>
+template <typename visitor>
+void csr_graph<t_vertex, t_edge>::for_each_neighbor(int vertex_id, visitor &&visit) const
+{
+    std::span<const int> vertex_targets = neighbors(vertex_id);
+    GRAPH_COUNT(edges_scanned, static_cast<long long>(vertex_targets.size()));
+    for (int u : vertex_targets)
+    {
+        visit(u);
+    }
+}
+
+template <typename t_vertex, typename t_edge>
+template <typename visitor>
+void csr_graph<t_vertex, t_edge>::for_each_edge(int vertex_id, visitor &&visit) const
+{
+    std::span<const int> vertex_targets = neighbors(vertex_id);
+    GRAPH_COUNT(edges_scanned, static_cast<long long>(vertex_targets.size()));
+    std::size_t first = offsets[vertex_id];
+    for (std::size_t i = 0; i < vertex_targets.size(); ++i)
+    {
+        visit(vertex_targets[i], weights[first + i]);
+    }
+}
+
+template <typename t_vertex, typename t_edge>
+const t_vertex &csr_graph<t_vertex, t_edge>::vertex_data(int vertex_id) const
+{
+    if (vertex_id < 0 || vertex_id >= vertex_count())
+    {
+        throw std::out_of_range("Invalid vertex ID");
+    }
+    return payloads[vertex_id];
+}
+
+template <typename t_vertex, typename t_edge>
+std::span<const t_vertex> csr_graph<t_vertex, t_edge>::payload_array() const
+{
+    return payloads;
+}
+
+template <typename t_vertex, typename t_edge>
+std::span<const std::size_t> csr_graph<t_vertex, t_edge>::offset_array() const
+{
+    return offsets;
+}
+
+template <typename t_vertex, typename t_edge>
+std::span<const int> csr_graph<t_vertex, t_edge>::target_array() const
+{
+    return targets;
+}
+
+template <typename t_vertex, typename t_edge>
+std::span<const t_edge> csr_graph<t_vertex, t_edge>::weight_array() const
+    requires is_weighted_v<t_edge>
+{
+    return weights.values;
+}
+
+template <typename t_vertex, typename t_edge>
+array_sequence<list_sequence<int>> csr_graph<t_vertex, t_edge>::find_connected_components() const
+{
+    components_workspace workspace(instrumentation::scratch_resource());
+    return connected_components(*this, workspace);
+}
+
+template <typename t_vertex, typename t_edge>
+std::vector<int> csr_graph<t_vertex, t_edge>::find_component_labels() const
+{
+    components_workspace workspace(instrumentation::scratch_resource());
+    return component_labels(*this, workspace);
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Min-heap of (key, id) with decrease-key, for ids in [0, n). Item and
+// position storage persists across clear(), so a heap reused for many
+// searches stops allocating once it has seen the largest one.
+template <typename t_key, int arity = 4>
+class dary_heap
+{
+private:
+    std::vector<std::pair<t_key, int>> items;
+    std::vector<int> position;
+
+    void place(std::size_t index, const std::pair<t_key, int> &item)
+    {
+        items[index] = item;
+        position[item.second] = static_cast<int>(index);
+    }
+
+    void sift_up(std::size_t index)
+    {
+        std::pair<t_key, int> item = items[index];
+        while (index > 0)
+        {
+            std::size_t parent = (index - 1) / arity;
+            if (!(item.first < items[parent].first))
+            {
+                break;
+            }
+            place(index, items[parent]);
+            index = parent;
+        }
+        place(index, item);
+    }
+
+    void sift_down(std::size_t index)
+    {
+        std::pair<t_key, int> item = items[index];
+        std::size_t count = items.size();
+        while (true)
+        {
+            std::size_t first = index * arity + 1;
+            if (first >= count)
+            {
+                break;
+            }
+            std::size_t last = first + arity < count ? first + arity : count;
+            std::size_t best = first;
+            for (std::size_t child = first + 1; child < last; ++child)
+            {
+                if (items[child].first < items[best].first)
+                {
+                    best = child;
+                }
+            }
+            if (!(items[best].first < item.first))
+            {
+                break;
+            }
+            place(index, items[best]);
+            index = best;
+        }
+        place(index, item);
+    }
+
+public:
+    // Makes ids [0, n) usable.
+    void reserve_ids(std::size_t n)
+    {
+        if (position.size() < n)
+        {
+            position.resize(n, -1);
+        }
+    }
+
+    bool empty() const { return items.empty(); }
+    std::size_t size() const { return items.size(); }
+    bool contains(int id) const { return position[id] >= 0; }
+
+    // Inserts `id`, or lowers its key if it is already queued with a larger
+    // one.
+    void push_or_decrease(int id, t_key key)
+    {
+        int index = position[id];
+        if (index < 0)
+        {
+            items.push_back({key, id});
+            sift_up(items.size() - 1);
+        }
+        else if (key < items[index].first)
+        {
+            items[index].first = key;
+            sift_up(static_cast<std::size_t>(index));
+        }
+    }
+
+    const std::pair<t_key, int> &top() const { return items.front(); }
+
+    std::pair<t_key, int> pop()
+    {
+        std::pair<t_key, int> result = items.front();
+        position[result.second] = -1;
+        std::pair<t_key, int> last = items.back();
+        items.pop_back();
+        if (!items.empty())
+        {
+            items.front() = last;
+            sift_down(0);
+        }
+        return result;
+    }
+
+    void clear()
+    {
+        for (const auto &item : items)
+        {
+            position[item.second] = -1;
+        }
+        items.clear();
+    }
+};
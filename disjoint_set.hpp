@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Sequential disjoint-set forest in a single int array: a non-negative
+// entry is the parent, a negative one marks a root and stores minus the
+// set's size. Keeping size and parent in one word means a find touches one
+// cache line per node. Union by size with path halving.
+class disjoint_set
+{
+private:
+    std::vector<int> entries;
+
+public:
+    disjoint_set() = default;
+    explicit disjoint_set(int count) : entries(count, -1) {}
+
+    int size() const { return static_cast<int>(entries.size()); }
+
+    int find(int element)
+    {
+        if (element < 0 || element >= size())
+        {
+            throw std::out_of_range("Invalid vertex ID");
+        }
+        while (entries[element] >= 0)
+        {
+            int parent = entries[element];
+            if (entries[parent] < 0)
+            {
+                return parent;
+            }
+            entries[element] = entries[parent];
+            element = entries[element];
+        }
+        return element;
+    }
+
+    // Returns false when both were already in the same set.
+    bool unite(int a, int b)
+    {
+        a = find(a);
+        b = find(b);
+        if (a == b)
+        {
+            return false;
+        }
+        if (entries[a] > entries[b])
+        {
+            std::swap(a, b);
+        }
+        entries[a] += entries[b];
+        entries[b] = a;
+        return true;
+    }
+
+    bool same_set(int a, int b) { return find(a) == find(b); }
+
+    int set_size(int element) { return -entries[find(element)]; }
+};
@@ -0,0 +1,474 @@
+#pragma once
+
+#include "graph_partition.hpp"
+#include "parallel_connected_components.hpp"
+#include "posix_file.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Connected components over a sharded graph by min-label propagation.
+//
+// Every vertex starts labeled with its global id. In each round a shard
+// lowers each of its owned vertices to the smallest label in its local
+// component (owned vertices plus ghosts, linked by the shard's edges), then
+// sends the labels of changed boundary vertices to the shards that hold
+// them as ghosts. Rounds repeat until nobody has anything to send; each
+// label then is its component's smallest vertex id, and the number of
+// rounds is bounded by how many shard crossings a component spans.
+//
+// The adjacency must be symmetric, as for parallel_component_labels.
+
+// One shard's side of the exchange. Updates are flat (local id on the
+// receiving shard, label) pairs.
+class component_shard_worker
+{
+private:
+    const graph_shard *shard;
+    std::vector<int> local_component;
+    std::vector<int> component_min;
+    std::vector<int> labels;
+    std::vector<char> unsent;
+
+public:
+    explicit component_shard_worker(const graph_shard &source)
+        : shard(&source), local_component(source.vertex_count()), labels(source.global_ids),
+          unsent(source.owned_count, 1)
+    {
+        // The shard's own components never change, only the labels flowing
+        // into them through ghosts.
+        int n = source.vertex_count();
+        min_hook_forest forest(n);
+        for (int v = 0; v < source.owned_count; ++v)
+        {
+            source.for_each_neighbor(v, [&](int u)
+                                     { forest.link(v, u); });
+        }
+        int count = 0;
+        std::vector<int> id_of_root(n, -1);
+        for (int v = 0; v < n; ++v)
+        {
+            int root = forest.find(v);
+            if (id_of_root[root] < 0)
+            {
+                id_of_root[root] = count++;
+            }
+            local_component[v] = id_of_root[root];
+        }
+        component_min.resize(count);
+    }
+
+    // Lowers owned labels to their local component minimum.
+    void settle()
+    {
+        std::fill(component_min.begin(), component_min.end(), std::numeric_limits<int>::max());
+        for (int v = 0; v < shard->vertex_count(); ++v)
+        {
+            int &best = component_min[local_component[v]];
+            best = std::min(best, labels[v]);
+        }
+        for (int v = 0; v < shard->owned_count; ++v)
+        {
+            int best = component_min[local_component[v]];
+            if (best < labels[v])
+            {
+                labels[v] = best;
+                unsent[v] = 1;
+            }
+        }
+    }
+
+    // Updates addressed to each shard, indexed by shard id.
+    std::vector<std::vector<int>> outgoing()
+    {
+        std::vector<std::vector<int>> updates(shard->shard_count);
+        for (const graph_shard::mirror &m : shard->mirrors)
+        {
+            if (unsent[m.local_id])
+            {
+                updates[m.shard].push_back(m.remote_id);
+                updates[m.shard].push_back(labels[m.local_id]);
+            }
+        }
+        std::fill(unsent.begin(), unsent.end(), 0);
+        return updates;
+    }
+
+    void receive(std::span<const int> updates)
+    {
+        if (updates.size() % 2 != 0)
+        {
+            throw std::runtime_error("Malformed label update");
+        }
+        for (std::size_t i = 0; i < updates.size(); i += 2)
+        {
+            int v = updates[i];
+            if (v < shard->owned_count || v >= shard->vertex_count())
+            {
+                throw std::runtime_error("Malformed label update");
+            }
+            labels[v] = std::min(labels[v], updates[i + 1]);
+        }
+    }
+
+    std::span<const int> owned_labels() const
+    {
+        return std::span<const int>(labels).first(shard->owned_count);
+    }
+};
+
+struct distributed_components_result
+{
+    // Same numbering as component_labels().
+    std::vector<int> labels;
+    int rounds = 0;
+    // Label updates sent between shards.
+    long long messages = 0;
+};
+
+// Turns per-shard minimum labels into component_labels() numbering: the
+// minima are the roots, numbered in vertex order.
+inline std::vector<int> labels_from_shards(const std::vector<graph_shard> &shards,
+                                           const std::vector<std::vector<int>> &owned_labels)
+{
+    int n = 0;
+    for (const graph_shard &shard : shards)
+    {
+        n += shard.owned_count;
+    }
+    std::vector<int> labels(n, -1);
+    for (std::size_t s = 0; s < shards.size(); ++s)
+    {
+        if (static_cast<int>(owned_labels[s].size()) != shards[s].owned_count)
+        {
+            throw std::runtime_error("Shard returned the wrong number of labels");
+        }
+        for (int v = 0; v < shards[s].owned_count; ++v)
+        {
+            int global = shards[s].global_id(v);
+            if (global < 0 || global >= n)
+            {
+                throw std::runtime_error("Shards do not cover the graph");
+            }
+            labels[global] = owned_labels[s][v];
+        }
+    }
+    std::vector<int> root_id(n, -1);
+    int next = 0;
+    for (int v = 0; v < n; ++v)
+    {
+        if (labels[v] == v)
+        {
+            root_id[v] = next++;
+        }
+    }
+    for (int v = 0; v < n; ++v)
+    {
+        if (labels[v] < 0 || labels[v] >= n || root_id[labels[v]] < 0)
+        {
+            throw std::runtime_error("Label propagation did not converge");
+        }
+        labels[v] = root_id[labels[v]];
+    }
+    return labels;
+}
+
+// Runs all shards in the calling process, one after another per round.
+inline distributed_components_result distributed_component_labels(const std::vector<graph_shard> &shards)
+{
+    std::vector<component_shard_worker> workers;
+    workers.reserve(shards.size());
+    for (const graph_shard &shard : shards)
+    {
+        workers.emplace_back(shard);
+    }
+
+    distributed_components_result result;
+    std::vector<std::vector<int>> inbox(shards.size());
+    while (true)
+    {
+        ++result.rounds;
+        long long sent = 0;
+        for (auto &mail : inbox)
+        {
+            mail.clear();
+        }
+        for (component_shard_worker &worker : workers)
+        {
+            worker.settle();
+            auto updates = worker.outgoing();
+            for (std::size_t s = 0; s < updates.size(); ++s)
+            {
+                inbox[s].insert(inbox[s].end(), updates[s].begin(), updates[s].end());
+                sent += updates[s].size() / 2;
+            }
+        }
+        if (sent == 0)
+        {
+            break;
+        }
+        result.messages += sent;
+        for (std::size_t s = 0; s < workers.size(); ++s)
+        {
+            workers[s].receive(inbox[s]);
+        }
+    }
+
+    std::vector<std::vector<int>> owned(shards.size());
+    for (std::size_t s = 0; s < workers.size(); ++s)
+    {
+        auto labels = workers[s].owned_labels();
+        owned[s].assign(labels.begin(), labels.end());
+    }
+    result.labels = labels_from_shards(shards, owned);
+    return result;
+}
+
+// Frames on a stream socket: a 32-bit length followed by that many ints.
+namespace shard_channel
+{
+    inline void send_all(int fd, const void *data, std::size_t bytes)
+    {
+        const char *cursor = static_cast<const char *>(data);
+        while (bytes > 0)
+        {
+            // MSG_NOSIGNAL: a dead peer is an error here, not a SIGPIPE.
+            ssize_t written = ::send(fd, cursor, bytes, MSG_NOSIGNAL);
+            if (written < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (written <= 0)
+            {
+                throw std::runtime_error("Shard exchange failed");
+            }
+            cursor += written;
+            bytes -= static_cast<std::size_t>(written);
+        }
+    }
+
+    inline void receive_all(int fd, void *data, std::size_t bytes)
+    {
+        char *cursor = static_cast<char *>(data);
+        while (bytes > 0)
+        {
+            ssize_t got = ::recv(fd, cursor, bytes, 0);
+            if (got < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (got <= 0)
+            {
+                throw std::runtime_error("Shard exchange failed");
+            }
+            cursor += got;
+            bytes -= static_cast<std::size_t>(got);
+        }
+    }
+
+    inline void send_frame(int fd, std::span<const int> values)
+    {
+        std::uint32_t length = static_cast<std::uint32_t>(values.size());
+        send_all(fd, &length, sizeof(length));
+        send_all(fd, values.data(), values.size() * sizeof(int));
+    }
+
+    inline std::vector<int> receive_frame(int fd)
+    {
+        std::uint32_t length = 0;
+        receive_all(fd, &length, sizeof(length));
+        std::vector<int> values(length);
+        receive_all(fd, values.data(), values.size() * sizeof(int));
+        return values;
+    }
+
+    enum command : int
+    {
+        stop,
+        next_round
+    };
+
+    // Worker side. Each round: settle, send one frame per shard, then read
+    // a command and, for next_round, the routed updates. On stop, send the
+    // owned labels back.
+    inline void serve(int fd, const graph_shard &shard)
+    {
+        component_shard_worker worker(shard);
+        while (true)
+        {
+            worker.settle();
+            for (const std::vector<int> &updates : worker.outgoing())
+            {
+                send_frame(fd, updates);
+            }
+            std::vector<int> command = receive_frame(fd);
+            if (command.size() != 1)
+            {
+                throw std::runtime_error("Malformed shard command");
+            }
+            if (command[0] == stop)
+            {
+                send_frame(fd, worker.owned_labels());
+                return;
+            }
+            worker.receive(receive_frame(fd));
+        }
+    }
+
+    // A forked worker and the coordinator's end of its socket. Closing the
+    // socket unblocks a worker that is still waiting, so the destructor can
+    // always reap it.
+    class worker_process
+    {
+    private:
+        pid_t pid = -1;
+        std::unique_ptr<file_descriptor> socket;
+
+    public:
+        worker_process(pid_t process, int fd) : pid(process), socket(std::make_unique<file_descriptor>(fd)) {}
+        worker_process(worker_process &&other) noexcept : pid(other.pid), socket(std::move(other.socket))
+        {
+            other.pid = -1;
+        }
+        worker_process &operator=(worker_process &&) = delete;
+
+        ~worker_process()
+        {
+            socket.reset();
+            if (pid > 0)
+            {
+                int status = 0;
+                while (::waitpid(pid, &status, 0) < 0 && errno == EINTR)
+                {
+                }
+            }
+        }
+
+        int fd() const { return socket->get(); }
+
+        // Waits for the worker and reports whether it exited cleanly.
+        bool join()
+        {
+            socket.reset();
+            int status = 0;
+            pid_t waited;
+            while ((waited = ::waitpid(pid, &status, 0)) < 0 && errno == EINTR)
+            {
+            }
+            pid = -1;
+            return waited > 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        }
+    };
+}
+
+// Runs every shard in its own forked process; the calling process routes
+// label updates between them over Unix domain sockets, as a coordinator
+// would between machines. Workers only touch their own shard.
+//
+// fork() copies just the calling thread, so call this before starting
+// other threads.
+inline distributed_components_result sharded_component_labels(const std::vector<graph_shard> &shards)
+{
+    using namespace shard_channel;
+
+    std::vector<worker_process> processes;
+    processes.reserve(shards.size());
+    for (std::size_t s = 0; s < shards.size(); ++s)
+    {
+        int pair[2];
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0)
+        {
+            throw std::runtime_error("Cannot create shard socket");
+        }
+        pid_t pid = ::fork();
+        if (pid < 0)
+        {
+            ::close(pair[0]);
+            ::close(pair[1]);
+            throw std::runtime_error("Cannot start shard process");
+        }
+        if (pid == 0)
+        {
+            ::close(pair[0]);
+            for (const worker_process &other : processes)
+            {
+                ::close(other.fd());
+            }
+            int code = 0;
+            try
+            {
+                serve(pair[1], shards[s]);
+            }
+            catch (...)
+            {
+                code = 1;
+            }
+            // Skips the parent's atexit handlers and stream buffers.
+            ::_exit(code);
+        }
+        ::close(pair[1]);
+        processes.emplace_back(pid, pair[0]);
+    }
+
+    distributed_components_result result;
+    std::vector<std::vector<int>> inbox(shards.size());
+    while (true)
+    {
+        ++result.rounds;
+        long long sent = 0;
+        for (auto &mail : inbox)
+        {
+            mail.clear();
+        }
+        for (worker_process &process : processes)
+        {
+            for (std::size_t target = 0; target < shards.size(); ++target)
+            {
+                std::vector<int> updates = receive_frame(process.fd());
+                inbox[target].insert(inbox[target].end(), updates.begin(), updates.end());
+                sent += updates.size() / 2;
+            }
+        }
+
+        int command = sent == 0 ? stop : next_round;
+        for (std::size_t s = 0; s < processes.size(); ++s)
+        {
+            send_frame(processes[s].fd(), std::span<const int>(&command, 1));
+            if (command == next_round)
+            {
+                send_frame(processes[s].fd(), inbox[s]);
+            }
+        }
+        if (command == stop)
+        {
+            break;
+        }
+        result.messages += sent;
+    }
+
+    std::vector<std::vector<int>> owned(shards.size());
+    for (std::size_t s = 0; s < processes.size(); ++s)
+    {
+        owned[s] = receive_frame(processes[s].fd());
+    }
+    for (worker_process &process : processes)
+    {
+        if (!process.join())
+        {
+            throw std::runtime_error("Shard process failed");
+        }
+    }
+    result.labels = labels_from_shards(shards, owned);
+    return result;
+}
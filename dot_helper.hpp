@@ -1,8 +1,14 @@
 #pragma once
+#include <fstream>
+#include <iostream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include "undirected_graph.hpp" 
+#include "csr_graph.hpp"
+#include "buffered_output.hpp"
+#include "posix_file.hpp"
 
 template <typename T>
 typename std::enable_if<std::is_arithmetic<T>::value, std::string>::type
@@ -27,54 +33,107 @@ vertex_to_string(const T &value)
     return oss.str();
 }
 
-template <typename t_vertex, typename t_edge = std::monostate>
-std::string to_dot(const undirected_graph<t_vertex, t_edge> &graph)
+// Appends `text` with every '"' written as '\\"', in one pass.
+inline void append_dot_escaped(buffered_output &out, std::string_view text)
 {
-    std::ostringstream dot;
-    dot << "graph G {\n";
-    dot << "    node [shape=circle, style=filled, fillcolor=lightblue, fontname=\"Arial\"];\n";
-    dot << "    edge [color=gray40];\n";
-
-    for (int i = 0; i < graph.vertex_count(); ++i)
+    std::size_t start = 0;
+    for (std::size_t i = 0; i < text.size(); ++i)
     {
-        std::string label = std::to_string(i) + ": " + vertex_to_string(graph.vertex_data(i));
-
-        size_t pos;
-        while ((pos = label.find('"')) != std::string::npos)
+        if (text[i] == '"')
         {
-            label.replace(pos, 1, "\\\"");
+            out.append(text.substr(start, i - start));
+            out.append("\\\"", 2);
+            start = i + 1;
         }
+    }
+    out.append(text.substr(start));
+}
 
-        dot << "    " << i << " [label=\"" << label << "\"];\n";
+template <typename T>
+void append_dot_label(buffered_output &out, const T &value)
+{
+    if constexpr (std::is_arithmetic<T>::value)
+    {
+        out.append_number(value);
+    }
+    else if constexpr (std::is_convertible<const T &, std::string_view>::value)
+    {
+        append_dot_escaped(out, std::string_view(value));
+    }
+    else
+    {
+        append_dot_escaped(out, vertex_to_string(value));
     }
+}
 
-    for (int u = 0; u < graph.vertex_count(); ++u)
+// Streams the DOT document into `out`. Each vertex's neighbors are visited
+// once and every undirected edge is written from its smaller endpoint.
+template <typename graph>
+void write_dot(const graph &gr, buffered_output &out)
+{
+    out.append("graph G {\n");
+    out.append("    node [shape=circle, style=filled, fillcolor=lightblue, fontname=\"Arial\"];\n");
+    out.append("    edge [color=gray40];\n");
+
+    for (int i = 0; i < gr.vertex_count(); ++i)
     {
-        auto neighbors = graph.neighbors(u);
-        for (int i = 0; i < neighbors.get_length(); ++i)
-        {
-            int v = neighbors.get(i);
+        out.append("    ");
+        out.append_number(i);
+        out.append(" [label=\"");
+        out.append_number(i);
+        out.append(": ");
+        append_dot_label(out, gr.vertex_data(i));
+        out.append("\"];\n");
+    }
+
+    for (int u = 0; u < gr.vertex_count(); ++u)
+    {
+        gr.for_each_neighbor(u, [&](int v)
+                             {
             if (u < v)
             {
-                dot << "    " << u << " -- " << v << ";\n";
-            }
-        }
+                out.append("    ");
+                out.append_number(u);
+                out.append(" -- ");
+                out.append_number(v);
+                out.append(";\n");
+            } });
     }
 
-    dot << "}\n";
-    return dot.str();
+    out.append("}\n");
+}
+
+template <typename graph>
+void write_dot(const graph &gr, std::ostream &stream)
+{
+    buffered_output out(stream);
+    write_dot(gr, out);
+    out.flush();
+}
+
+template <typename graph>
+std::string to_dot(const graph &gr)
+{
+    std::string dot;
+    {
+        buffered_output out(dot, 1 << 16);
+        write_dot(gr, out);
+        out.flush();
+    }
+    return dot;
 }
 
 template <typename graph>
 void export_to_dot(const graph &gr, const std::string &filename = "graph.dot")
 {
-    std::ofstream out(filename);
-    if (!out.is_open())
+    file_descriptor fd(::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644));
+    if (fd.get() < 0)
     {
         std::cerr << "Error: cannot open file " << filename << "\n";
         return;
     }
-    out << gr.to_dot();
-    out.close();
+    buffered_output out(fd.get());
+    write_dot(gr, out);
+    out.flush();
     std::cout << "Graph exported to " << filename << "\n";
-}
\ No newline at end of file
+}
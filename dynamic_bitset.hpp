@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+class dynamic_bitset
+{
+private:
+    std::pmr::vector<std::uint64_t> words;
+    std::size_t bit_count = 0;
+
+public:
+    dynamic_bitset() = default;
+    explicit dynamic_bitset(std::size_t size) { assign(size); }
+    explicit dynamic_bitset(std::pmr::memory_resource *resource) : words(resource) {}
+
+    // Resizes to `size` bits and clears all of them, reusing the storage.
+    void assign(std::size_t size)
+    {
+        bit_count = size;
+        words.assign((size + 63) / 64, 0);
+    }
+
+    std::size_t size() const { return bit_count; }
+
+    bool test(std::size_t index) const
+    {
+        return (words[index >> 6] >> (index & 63)) & 1u;
+    }
+
+    void set(std::size_t index)
+    {
+        words[index >> 6] |= std::uint64_t{1} << (index & 63);
+    }
+
+    void reset(std::size_t index)
+    {
+        words[index >> 6] &= ~(std::uint64_t{1} << (index & 63));
+    }
+
+    // Sets the bit and reports whether it was already set.
+    bool test_and_set(std::size_t index)
+    {
+        std::uint64_t mask = std::uint64_t{1} << (index & 63);
+        std::uint64_t &word = words[index >> 6];
+        bool was_set = (word & mask) != 0;
+        word |= mask;
+        return was_set;
+    }
+
+    void clear()
+    {
+        for (auto &word : words)
+        {
+            word = 0;
+        }
+    }
+
+    std::size_t word_count() const { return words.size(); }
+    std::uint64_t *data() { return words.data(); }
+    const std::uint64_t *data() const { return words.data(); }
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "undirected_graph.hpp"
+#include "level_spanning_forest.hpp"
+#include "graph_observer.hpp"
+#include <algorithm>
+#include <vector>
+
+// Connectivity kept in sync with an undirected_graph under both edge
+// insertions and removals. Each vertex's last generator output is kept, so a
+// set_edge_generator call is applied as the difference between the old and
+// new neighbor lists. The edge {u, v} exists as many times as u lists v plus
+// v lists u.
+//
+// Not thread-safe: queries and graph mutations need external
+// synchronization.
+template <typename t_vertex, typename t_edge = std::monostate>
+class dynamic_connectivity : public graph_observer
+{
+private:
+    undirected_graph<t_vertex, t_edge> *graph;
+    level_spanning_forest forest;
+    std::vector<std::vector<int>> reported;
+
+    std::vector<int> current_neighbors(int vertex_id) const
+    {
+        std::vector<int> neighbors;
+        graph->for_each_neighbor(vertex_id, [&](int u)
+                                 { neighbors.push_back(u); });
+        std::sort(neighbors.begin(), neighbors.end());
+        return neighbors;
+    }
+
+public:
+    explicit dynamic_connectivity(undirected_graph<t_vertex, t_edge> &source)
+        : graph(&source), forest(source.vertex_count()), reported(source.vertex_count())
+    {
+        for (int v = 0; v < source.vertex_count(); ++v)
+        {
+            reported[v] = current_neighbors(v);
+            for (int u : reported[v])
+            {
+                forest.insert_edge(v, u);
+            }
+        }
+        graph->attach_observer(this);
+    }
+
+    dynamic_connectivity(const dynamic_connectivity &) = delete;
+    dynamic_connectivity &operator=(const dynamic_connectivity &) = delete;
+
+    ~dynamic_connectivity() override
+    {
+        graph->detach_observer(this);
+    }
+
+    void on_vertex_added(int vertex_id) override
+    {
+        forest.add_vertices(vertex_id + 1);
+        reported.resize(vertex_id + 1);
+    }
+
+    // Insertions go first so that a rewired edge does not split and rejoin
+    // a component on the way.
+    void on_edges_changed(int vertex_id) override
+    {
+        std::vector<int> updated = current_neighbors(vertex_id);
+        const std::vector<int> &previous = reported[vertex_id];
+
+        std::vector<int> added;
+        std::vector<int> removed;
+        std::set_difference(updated.begin(), updated.end(), previous.begin(), previous.end(),
+                            std::back_inserter(added));
+        std::set_difference(previous.begin(), previous.end(), updated.begin(), updated.end(),
+                            std::back_inserter(removed));
+
+        for (int u : added)
+        {
+            forest.insert_edge(vertex_id, u);
+        }
+        for (int u : removed)
+        {
+            forest.delete_edge(vertex_id, u);
+        }
+        reported[vertex_id] = std::move(updated);
+    }
+
+    // Edges that arrive outside the graph's generators.
+    bool insert_edge(int u, int v)
+    {
+        return forest.insert_edge(u, v);
+    }
+
+    bool delete_edge(int u, int v)
+    {
+        return forest.delete_edge(u, v);
+    }
+
+    bool connected(int u, int v) const
+    {
+        return forest.connected(u, v);
+    }
+
+    int component_count() const
+    {
+        return forest.component_count();
+    }
+
+    int component_size(int v) const
+    {
+        return forest.component_size(v);
+    }
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <variant>
+
+// std::monostate as t_edge means the graph is unweighted.
+template <typename t_edge>
+inline constexpr bool is_weighted_v = !std::is_same_v<t_edge, std::monostate>;
+
+template <typename t_edge>
+struct edge
+{
+    int target;
+    t_edge data;
+
+    edge() = default;
+    edge(int target, const t_edge &data) : target(target), data(data) {}
+};
+
+// What an edge generator lists per neighbor: the bare id when unweighted.
+template <typename t_edge>
+using adjacency_entry = std::conditional_t<is_weighted_v<t_edge>, edge<t_edge>, int>;
+
+inline int entry_target(int target)
+{
+    return target;
+}
+
+template <typename t_edge>
+int entry_target(const edge<t_edge> &entry)
+{
+    return entry.target;
+}
+
+// Weights stored parallel to the neighbor ids. The monostate version is an
+// empty type that hands out a shared monostate, so unweighted graphs store
+// nothing per edge.
+template <typename t_edge>
+struct edge_weight_span
+{
+    std::span<const t_edge> values;
+
+    edge_weight_span() = default;
+    edge_weight_span(std::span<const t_edge> weights) : values(weights) {}
+
+    const t_edge &operator[](std::size_t index) const { return values[index]; }
+    std::size_t size() const { return values.size(); }
+
+    edge_weight_span subspan(std::size_t offset, std::size_t count) const
+    {
+        return values.subspan(offset, count);
+    }
+};
+
+template <>
+struct edge_weight_span<std::monostate>
+{
+    edge_weight_span() = default;
+    edge_weight_span(std::span<const std::monostate>) {}
+
+    const std::monostate &operator[](std::size_t) const
+    {
+        static constexpr std::monostate none;
+        return none;
+    }
+
+    edge_weight_span subspan(std::size_t, std::size_t) const { return {}; }
+};
+
+template <typename t_edge>
+struct weighted_neighbor
+{
+    int target;
+    const t_edge &weight;
+};
+
+// Neighbor + weight view of one vertex's adjacency.
+template <typename t_edge>
+class edge_range
+{
+private:
+    std::span<const int> targets;
+    [[no_unique_address]] edge_weight_span<t_edge> weights;
+
+public:
+    class iterator
+    {
+    private:
+        const edge_range *range = nullptr;
+        std::size_t index = 0;
+
+    public:
+        iterator() = default;
+        iterator(const edge_range *range, std::size_t index) : range(range), index(index) {}
+
+        weighted_neighbor<t_edge> operator*() const
+        {
+            return {range->targets[index], range->weights[index]};
+        }
+
+        iterator &operator++()
+        {
+            ++index;
+            return *this;
+        }
+
+        bool operator==(const iterator &other) const { return index == other.index; }
+        bool operator!=(const iterator &other) const { return index != other.index; }
+    };
+
+    edge_range() = default;
+    edge_range(std::span<const int> targets, edge_weight_span<t_edge> weights)
+        : targets(targets), weights(weights)
+    {
+    }
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, targets.size()); }
+    std::size_t size() const { return targets.size(); }
+    bool empty() const { return targets.empty(); }
+};
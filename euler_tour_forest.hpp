@@ -0,0 +1,278 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Forest of Euler tours kept as treaps, supporting link, cut and
+// connectivity in O(log n) expected time.
+//
+// A tree's tour is a cyclic sequence holding one node per vertex and one
+// node per direction of every tree edge. Any rotation of it is still a tour,
+// so rerooting is a split and a merge. Vertex nodes are created on first use;
+// a vertex without one is a tree of its own.
+//
+// Every node carries two flag bits whose subtree OR is maintained, so a
+// flagged node anywhere in a tree is found in O(log n).
+class euler_tour_forest
+{
+private:
+    struct node
+    {
+        int left = -1;
+        int right = -1;
+        int parent = -1;
+        std::uint32_t priority = 0;
+        int count = 1;
+        int vertices = 0;
+        std::uint8_t flags = 0;
+        std::uint8_t subtree_flags = 0;
+        // (v, v) for a vertex node, (u, v) for the arc u -> v.
+        int from = -1;
+        int to = -1;
+    };
+
+    std::vector<node> nodes;
+    std::vector<int> free_nodes;
+    std::vector<int> vertex_nodes;
+    std::minstd_rand rng{12345};
+
+    int count_of(int x) const { return x < 0 ? 0 : nodes[x].count; }
+    int vertices_of(int x) const { return x < 0 ? 0 : nodes[x].vertices; }
+    std::uint8_t flags_of(int x) const { return x < 0 ? 0 : nodes[x].subtree_flags; }
+
+    void update(int x)
+    {
+        node &n = nodes[x];
+        n.count = 1 + count_of(n.left) + count_of(n.right);
+        n.vertices = (n.from == n.to ? 1 : 0) + vertices_of(n.left) + vertices_of(n.right);
+        n.subtree_flags = n.flags | flags_of(n.left) | flags_of(n.right);
+    }
+
+    void refresh_to_root(int x)
+    {
+        for (; x >= 0; x = nodes[x].parent)
+        {
+            update(x);
+        }
+    }
+
+    int make_node(int from, int to)
+    {
+        int x;
+        if (!free_nodes.empty())
+        {
+            x = free_nodes.back();
+            free_nodes.pop_back();
+            nodes[x] = node{};
+        }
+        else
+        {
+            x = static_cast<int>(nodes.size());
+            nodes.emplace_back();
+        }
+        nodes[x].priority = static_cast<std::uint32_t>(rng());
+        nodes[x].from = from;
+        nodes[x].to = to;
+        update(x);
+        return x;
+    }
+
+    int merge(int a, int b)
+    {
+        if (a < 0)
+        {
+            return b;
+        }
+        if (b < 0)
+        {
+            return a;
+        }
+        if (nodes[a].priority > nodes[b].priority)
+        {
+            int right = merge(nodes[a].right, b);
+            nodes[a].right = right;
+            nodes[right].parent = a;
+            update(a);
+            return a;
+        }
+        int left = merge(a, nodes[b].left);
+        nodes[b].left = left;
+        nodes[left].parent = b;
+        update(b);
+        return b;
+    }
+
+    // First k nodes of the sequence rooted at t, and the rest. Both results
+    // have no parent.
+    std::pair<int, int> split(int t, int k)
+    {
+        if (t < 0)
+        {
+            return {-1, -1};
+        }
+        nodes[t].parent = -1;
+        if (count_of(nodes[t].left) >= k)
+        {
+            auto [first, rest] = split(nodes[t].left, k);
+            nodes[t].left = rest;
+            if (rest >= 0)
+            {
+                nodes[rest].parent = t;
+            }
+            update(t);
+            return {first, t};
+        }
+        auto [first, rest] = split(nodes[t].right, k - count_of(nodes[t].left) - 1);
+        nodes[t].right = first;
+        if (first >= 0)
+        {
+            nodes[first].parent = t;
+        }
+        update(t);
+        return {t, rest};
+    }
+
+    int root(int x) const
+    {
+        while (nodes[x].parent >= 0)
+        {
+            x = nodes[x].parent;
+        }
+        return x;
+    }
+
+    int index(int x) const
+    {
+        int position = count_of(nodes[x].left);
+        while (nodes[x].parent >= 0)
+        {
+            int p = nodes[x].parent;
+            if (nodes[p].right == x)
+            {
+                position += count_of(nodes[p].left) + 1;
+            }
+            x = p;
+        }
+        return position;
+    }
+
+    int vertex_node(int v)
+    {
+        if (vertex_nodes[v] < 0)
+        {
+            vertex_nodes[v] = make_node(v, v);
+        }
+        return vertex_nodes[v];
+    }
+
+    // Rotates v's tour so that it starts at v; returns the new root.
+    int reroot(int v)
+    {
+        int x = vertex_node(v);
+        auto [before, after] = split(root(x), index(x));
+        return merge(after, before);
+    }
+
+public:
+    static constexpr std::uint8_t tree_edge_flag = 1;
+    static constexpr std::uint8_t nontree_edge_flag = 2;
+
+    void add_vertices(int vertex_count)
+    {
+        if (vertex_count > static_cast<int>(vertex_nodes.size()))
+        {
+            vertex_nodes.resize(vertex_count, -1);
+        }
+    }
+
+    bool connected(int u, int v) const
+    {
+        if (u == v)
+        {
+            return true;
+        }
+        int x = vertex_nodes[u];
+        int y = vertex_nodes[v];
+        return x >= 0 && y >= 0 && root(x) == root(y);
+    }
+
+    int tree_size(int v) const
+    {
+        int x = vertex_nodes[v];
+        return x < 0 ? 1 : nodes[root(x)].vertices;
+    }
+
+    // Joins the trees of u and v, which must differ. Returns the nodes of the
+    // arcs u -> v and v -> u, which cut() needs.
+    std::pair<int, int> link(int u, int v)
+    {
+        int tour_u = reroot(u);
+        int tour_v = reroot(v);
+        int forward = make_node(u, v);
+        int backward = make_node(v, u);
+        merge(merge(merge(tour_u, forward), tour_v), backward);
+        return {forward, backward};
+    }
+
+    void cut(int forward, int backward)
+    {
+        int first = index(forward);
+        int second = index(backward);
+        if (first > second)
+        {
+            std::swap(first, second);
+        }
+        auto [head, rest] = split(root(forward), first);
+        auto [first_arc, middle_and_tail] = split(rest, 1);
+        auto [middle, tail] = split(middle_and_tail, second - first - 1);
+        auto [second_arc, end] = split(tail, 1);
+        merge(end, head);
+        (void)middle;
+        free_nodes.push_back(first_arc);
+        free_nodes.push_back(second_arc);
+    }
+
+    void set_arc_flag(int arc, std::uint8_t flag, bool on)
+    {
+        nodes[arc].flags = on ? (nodes[arc].flags | flag) : (nodes[arc].flags & ~flag);
+        refresh_to_root(arc);
+    }
+
+    void set_vertex_flag(int v, std::uint8_t flag, bool on)
+    {
+        if (!on && vertex_nodes[v] < 0)
+        {
+            return;
+        }
+        set_arc_flag(vertex_node(v), flag, on);
+    }
+
+    // Some node in v's tree carrying `flag`, or -1.
+    int find_flagged(int v, std::uint8_t flag) const
+    {
+        int x = vertex_nodes[v];
+        if (x < 0)
+        {
+            return -1;
+        }
+        x = root(x);
+        if (!(nodes[x].subtree_flags & flag))
+        {
+            return -1;
+        }
+        while (!(nodes[x].flags & flag))
+        {
+            int left = nodes[x].left;
+            x = (left >= 0 && (nodes[left].subtree_flags & flag)) ? left : nodes[x].right;
+        }
+        return x;
+    }
+
+    // (u, v) for the arc u -> v, (v, v) for the vertex node of v.
+    std::pair<int, int> endpoints(int x) const
+    {
+        return {nodes[x].from, nodes[x].to};
+    }
+};
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "csr_graph.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+struct build_options
+{
+    // Store every edge in both endpoint lists.
+    bool symmetrize = true;
+    // Sort each neighbor list and drop repeated targets.
+    bool deduplicate = true;
+    bool drop_self_loops = false;
+    // 1 builds on the calling thread, non-positive means all cores.
+    int thread_count = 1;
+};
+
+// Builds a CSR graph from an edge list in three large allocations (offsets,
+// targets, cursors) plus one more when deduplication removes edges. Edges
+// are bucketed by source with a counting sort; with several threads the
+// counting and scatter passes use atomic increments on shared counters.
+template <typename t_vertex>
+csr_graph<t_vertex> build_csr_graph(std::vector<t_vertex> payloads, std::span<const std::pair<int, int>> edges,
+                                    const build_options &options = {})
+{
+    int n = static_cast<int>(payloads.size());
+    int m = static_cast<int>(edges.size());
+    int threads = resolve_thread_count(options.thread_count);
+
+    std::atomic<bool> invalid(false);
+    parallel_for(0, m, threads, [&](int i)
+                 {
+        auto [u, v] = edges[i];
+        if (u < 0 || u >= n || v < 0 || v >= n)
+        {
+            invalid.store(true, std::memory_order_relaxed);
+        } });
+    if (invalid.load())
+    {
+        throw std::out_of_range("Invalid vertex ID");
+    }
+
+    auto keeps = [&](int u, int v)
+    {
+        return !(options.drop_self_loops && u == v);
+    };
+    auto mirrored = [&](int u, int v)
+    {
+        return options.symmetrize && u != v;
+    };
+    // Locked increments are several times slower than plain ones even when
+    // uncontended, so they are only used when other threads can interfere.
+    auto bump = [&](std::size_t &counter) -> std::size_t
+    {
+        if (threads == 1)
+        {
+            return counter++;
+        }
+        return std::atomic_ref<std::size_t>(counter).fetch_add(1, std::memory_order_relaxed);
+    };
+
+    std::vector<std::size_t> offsets(n + 1, 0);
+    parallel_for(0, m, threads, [&](int i)
+                 {
+        auto [u, v] = edges[i];
+        if (keeps(u, v))
+        {
+            bump(offsets[u + 1]);
+            if (mirrored(u, v))
+            {
+                bump(offsets[v + 1]);
+            }
+        } });
+
+    for (int v = 0; v < n; ++v)
+    {
+        offsets[v + 1] += offsets[v];
+    }
+
+    std::vector<int> targets(offsets[n]);
+    std::vector<std::size_t> cursor(offsets.begin(), offsets.end() - 1);
+    parallel_for(0, m, threads, [&](int i)
+                 {
+        auto [u, v] = edges[i];
+        if (keeps(u, v))
+        {
+            targets[bump(cursor[u])] = v;
+            if (mirrored(u, v))
+            {
+                targets[bump(cursor[v])] = u;
+            }
+        } });
+
+    if (options.deduplicate)
+    {
+        // Sort and unique each list in place, remember the new lengths in
+        // cursor, then compact into a fresh array only if something was
+        // actually removed.
+        std::atomic<bool> shrunk(false);
+        parallel_for(0, n, threads, [&](int v)
+                     {
+            auto first = targets.begin() + offsets[v];
+            auto last = targets.begin() + offsets[v + 1];
+            std::sort(first, last);
+            auto unique_end = std::unique(first, last);
+            cursor[v] = static_cast<std::size_t>(unique_end - first);
+            if (unique_end != last)
+            {
+                shrunk.store(true, std::memory_order_relaxed);
+            } },
+                     256);
+
+        if (shrunk.load())
+        {
+            std::vector<std::size_t> compact_offsets(n + 1, 0);
+            for (int v = 0; v < n; ++v)
+            {
+                compact_offsets[v + 1] = compact_offsets[v] + cursor[v];
+            }
+
+            std::vector<int> compact_targets(compact_offsets[n]);
+            parallel_for(0, n, threads, [&](int v)
+                         { std::copy_n(targets.begin() + offsets[v], cursor[v],
+                                       compact_targets.begin() + compact_offsets[v]); },
+                         256);
+
+            offsets = std::move(compact_offsets);
+            targets = std::move(compact_targets);
+        }
+    }
+
+    return csr_graph<t_vertex>(std::move(payloads), std::move(offsets), std::move(targets));
+}
+
+// Generator-based graph backed by one shared CSR built in bulk. Each
+// generator only captures a pointer to the snapshot and its vertex id.
+template <typename t_vertex>
+undirected_graph<t_vertex> build_undirected_graph(std::vector<t_vertex> payloads,
+                                                  std::span<const std::pair<int, int>> edges,
+                                                  const build_options &options = {})
+{
+    auto snapshot = std::make_shared<const csr_graph<t_vertex>>(build_csr_graph(std::move(payloads), edges, options));
+
+    undirected_graph<t_vertex> graph;
+    for (int v = 0; v < snapshot->vertex_count(); ++v)
+    {
+        graph.add_vertex(snapshot->vertex_data(v));
+    }
+    for (int v = 0; v < snapshot->vertex_count(); ++v)
+    {
+        graph.set_edge_generator(v, [snapshot, v]()
+                                 {
+            list_sequence<int> neighbors;
+            for (int u : snapshot->neighbors(v))
+            {
+                neighbors.append_element(u);
+            }
+            return neighbors; });
+    }
+    return graph;
+}
@@ -0,0 +1,300 @@
+#pragma once
+
+#include "csr_graph.hpp"
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "posix_file.hpp"
+
+// Binary CSR file, version 1. Native little-endian layout so that sections
+// can be used in place from a read-only mapping:
+//
+//   graph_file_header                  (one 128-byte block)
+//   offsets   uint64 x (vertices + 1)  (64-byte aligned)
+//   targets   int32  x arcs            (64-byte aligned)
+//   payloads  t_vertex x vertices      (64-byte aligned, optional)
+//
+// Each section carries its own checksum; the header checksums itself.
+namespace graph_file
+{
+    inline constexpr char magic[8] = {'U', 'G', 'R', 'A', 'P', 'H', 'C', 'S'};
+    inline constexpr std::uint32_t version = 1;
+    inline constexpr std::uint32_t endian_marker = 0x01020304;
+    inline constexpr std::uint64_t alignment = 64;
+
+    enum section : int
+    {
+        offsets_section,
+        targets_section,
+        payloads_section,
+        section_count
+    };
+
+    struct section_entry
+    {
+        std::uint64_t position;
+        std::uint64_t bytes;
+        std::uint64_t checksum;
+    };
+
+    struct header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t endian_marker;
+        std::uint64_t vertex_count;
+        std::uint64_t arc_count;
+        std::uint32_t payload_size;
+        std::uint32_t flags;
+        section_entry sections[section_count];
+        std::uint64_t header_checksum;
+    };
+
+    inline constexpr std::uint32_t has_payloads = 1;
+    inline constexpr std::uint64_t header_block = 128;
+
+    static_assert(sizeof(header) <= header_block);
+    static_assert(sizeof(std::size_t) == sizeof(std::uint64_t), "offsets are mapped in place as uint64");
+    static_assert(sizeof(int) == sizeof(std::int32_t), "targets are mapped in place as int32");
+
+    // Word-at-a-time multiplicative hash; reads 8 bytes per step.
+    inline std::uint64_t checksum(const void *data, std::size_t bytes)
+    {
+        const auto *p = static_cast<const unsigned char *>(data);
+        std::uint64_t hash = 0x9E3779B97F4A7C15ull ^ bytes;
+        std::size_t i = 0;
+        for (; i + 8 <= bytes; i += 8)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, p + i, 8);
+            hash = (hash ^ word) * 0x100000001B3ull;
+            hash ^= hash >> 29;
+        }
+        std::uint64_t tail = 0;
+        if (i < bytes)
+        {
+            std::memcpy(&tail, p + i, bytes - i);
+        }
+        hash = (hash ^ tail) * 0x100000001B3ull;
+        return hash ^ (hash >> 32);
+    }
+
+    inline std::uint64_t header_checksum(header h)
+    {
+        h.header_checksum = 0;
+        return checksum(&h, sizeof(h));
+    }
+
+    inline std::uint64_t align_up(std::uint64_t value)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+struct graph_load_options
+{
+    // Hash every section. Touches the whole file.
+    bool verify_checksums = true;
+    // Check offsets are monotone and targets are valid vertex ids. Touches
+    // offsets and targets. With both checks off a load only reads the header
+    // and the mapping is faulted in lazily.
+    bool validate_structure = true;
+};
+
+// Payloads are stored only when t_vertex is trivially copyable.
+template <typename t_vertex, typename t_edge>
+void save_graph_file(const csr_graph<t_vertex, t_edge> &graph, const std::string &filename)
+{
+    using namespace graph_file;
+    static_assert(!is_weighted_v<t_edge>, "graph files do not store edge weights");
+
+    constexpr bool store_payloads = std::is_trivially_copyable_v<t_vertex>;
+
+    // A default-constructed graph has no offsets at all; store the single 0.
+    static const std::size_t empty_offsets[1] = {0};
+    auto offsets = graph.offset_array().empty() ? std::span<const std::size_t>(empty_offsets) : graph.offset_array();
+    auto targets = graph.target_array();
+    std::uint64_t n = graph.vertex_count();
+
+    header h{};
+    std::memcpy(h.magic, magic, sizeof(magic));
+    h.version = version;
+    h.endian_marker = endian_marker;
+    h.vertex_count = n;
+    h.arc_count = targets.size();
+    h.payload_size = store_payloads ? sizeof(t_vertex) : 0;
+    h.flags = store_payloads ? has_payloads : 0;
+
+    std::uint64_t position = header_block;
+    h.sections[offsets_section] = {position, offsets.size_bytes(), checksum(offsets.data(), offsets.size_bytes())};
+    position = align_up(position + offsets.size_bytes());
+    h.sections[targets_section] = {position, targets.size_bytes(), checksum(targets.data(), targets.size_bytes())};
+    position = align_up(position + targets.size_bytes());
+
+    std::span<const unsigned char> payload_bytes;
+    if constexpr (store_payloads)
+    {
+        auto payloads = graph.payload_array();
+        payload_bytes = std::span<const unsigned char>(reinterpret_cast<const unsigned char *>(payloads.data()),
+                                                       payloads.size_bytes());
+    }
+    h.sections[payloads_section] = {position, payload_bytes.size(), checksum(payload_bytes.data(), payload_bytes.size())};
+    position += payload_bytes.size();
+    h.header_checksum = header_checksum(h);
+
+    file_descriptor fd(::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644));
+    if (fd.get() < 0)
+    {
+        throw std::runtime_error("Cannot open file " + filename);
+    }
+    if (::ftruncate(fd.get(), static_cast<off_t>(position)) != 0)
+    {
+        throw std::runtime_error("Cannot resize file " + filename);
+    }
+
+    mapped_region out(fd.get(), position, true);
+    std::memcpy(out.data(), &h, sizeof(h));
+    std::memcpy(out.data() + h.sections[offsets_section].position, offsets.data(), offsets.size_bytes());
+    if (!targets.empty())
+    {
+        std::memcpy(out.data() + h.sections[targets_section].position, targets.data(), targets.size_bytes());
+    }
+    if (!payload_bytes.empty())
+    {
+        std::memcpy(out.data() + h.sections[payloads_section].position, payload_bytes.data(), payload_bytes.size());
+    }
+    if (::msync(out.data(), out.size(), MS_SYNC) != 0)
+    {
+        throw std::runtime_error("Cannot write file " + filename);
+    }
+}
+
+// Maps the file read-only and returns a csr_graph that views it in place.
+// Payloads are viewed in place too when the file has them and t_vertex
+// matches; otherwise vertices get value-initialized payloads.
+template <typename t_vertex, typename t_edge = std::monostate>
+csr_graph<t_vertex, t_edge> load_graph_file(const std::string &filename, const graph_load_options &options = {})
+{
+    using namespace graph_file;
+    static_assert(!is_weighted_v<t_edge>, "graph files do not store edge weights");
+
+    file_descriptor fd(::open(filename.c_str(), O_RDONLY));
+    if (fd.get() < 0)
+    {
+        throw std::runtime_error("Cannot open file " + filename);
+    }
+
+    struct stat info;
+    if (::fstat(fd.get(), &info) != 0)
+    {
+        throw std::runtime_error("Cannot stat file " + filename);
+    }
+    std::uint64_t file_size = static_cast<std::uint64_t>(info.st_size);
+    if (file_size < header_block)
+    {
+        throw std::runtime_error("Truncated graph file " + filename);
+    }
+
+    auto map = std::make_shared<mapped_region>(fd.get(), file_size, false);
+
+    header h;
+    std::memcpy(&h, map->data(), sizeof(h));
+    if (std::memcmp(h.magic, magic, sizeof(magic)) != 0)
+    {
+        throw std::runtime_error("Not a graph file: " + filename);
+    }
+    if (h.version != version)
+    {
+        throw std::runtime_error("Unsupported graph file version in " + filename);
+    }
+    if (h.endian_marker != endian_marker)
+    {
+        throw std::runtime_error("Graph file byte order does not match this machine: " + filename);
+    }
+    if (h.header_checksum != header_checksum(h))
+    {
+        throw std::runtime_error("Corrupt graph file header in " + filename);
+    }
+    if (h.vertex_count > static_cast<std::uint64_t>(std::numeric_limits<int>::max()))
+    {
+        throw std::runtime_error("Too many vertices in " + filename);
+    }
+    // A valid header checksum proves nothing about the counts; bound them by
+    // the file size so the section sizes below cannot wrap.
+    if (h.vertex_count >= file_size / sizeof(std::uint64_t) || h.arc_count > file_size / sizeof(std::int32_t) ||
+        ((h.flags & has_payloads) && h.payload_size != 0 && h.vertex_count > file_size / h.payload_size))
+    {
+        throw std::runtime_error("Graph file section out of bounds in " + filename);
+    }
+
+    std::uint64_t expected_bytes[section_count] = {
+        (h.vertex_count + 1) * sizeof(std::uint64_t),
+        h.arc_count * sizeof(std::int32_t),
+        (h.flags & has_payloads) ? h.vertex_count * h.payload_size : 0};
+
+    for (int s = 0; s < section_count; ++s)
+    {
+        const section_entry &entry = h.sections[s];
+        if (entry.bytes != expected_bytes[s] || entry.position % alignment != 0 ||
+            entry.position < header_block || entry.position > file_size || entry.bytes > file_size - entry.position)
+        {
+            throw std::runtime_error("Graph file section out of bounds in " + filename);
+        }
+        if (options.verify_checksums && entry.checksum != checksum(map->data() + entry.position, entry.bytes))
+        {
+            throw std::runtime_error("Graph file checksum mismatch in " + filename);
+        }
+    }
+
+    int n = static_cast<int>(h.vertex_count);
+    std::span<const std::size_t> offsets(
+        reinterpret_cast<const std::size_t *>(map->data() + h.sections[offsets_section].position), n + 1);
+    std::span<const int> targets(
+        reinterpret_cast<const int *>(map->data() + h.sections[targets_section].position), h.arc_count);
+
+    if (offsets.front() != 0 || offsets.back() != h.arc_count)
+    {
+        throw std::runtime_error("Invalid CSR offsets in " + filename);
+    }
+    if (options.validate_structure)
+    {
+        for (int v = 0; v < n; ++v)
+        {
+            if (offsets[v] > offsets[v + 1])
+            {
+                throw std::runtime_error("Invalid CSR offsets in " + filename);
+            }
+        }
+        for (int u : targets)
+        {
+            if (u < 0 || u >= n)
+            {
+                throw std::runtime_error("Invalid vertex ID in " + filename);
+            }
+        }
+    }
+
+    if constexpr (std::is_trivially_copyable_v<t_vertex>)
+    {
+        if ((h.flags & has_payloads) && h.payload_size == sizeof(t_vertex))
+        {
+            std::span<const t_vertex> payloads(
+                reinterpret_cast<const t_vertex *>(map->data() + h.sections[payloads_section].position), n);
+            return csr_graph<t_vertex, t_edge>(map, payloads, offsets, targets);
+        }
+    }
+    if (h.flags & has_payloads)
+    {
+        throw std::runtime_error("Graph file payload type does not match in " + filename);
+    }
+
+    auto owned = std::make_shared<std::pair<std::shared_ptr<mapped_region>, std::vector<t_vertex>>>(map, std::vector<t_vertex>(n));
+    return csr_graph<t_vertex, t_edge>(owned, owned->second, offsets, targets);
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Edge-list generators for benchmarks and tests. All run in O(n + m) and
+// return each undirected edge once; feed them to build_csr_graph or
+// build_undirected_graph, which add the reverse arcs.
+
+// Erdos-Renyi G(n, p) without self loops or parallel edges. Skips straight
+// to the next present pair with a geometric draw (Batagelj and Brandes)
+// instead of flipping a coin for all n^2 / 2 pairs.
+template <typename rng_type>
+std::vector<std::pair<int, int>> erdos_renyi_edges(int n, double p, rng_type &rng)
+{
+    std::vector<std::pair<int, int>> edges;
+    if (n < 2 || p <= 0.0)
+    {
+        return edges;
+    }
+    if (p >= 1.0)
+    {
+        for (int v = 1; v < n; ++v)
+        {
+            for (int w = 0; w < v; ++w)
+            {
+                edges.push_back({v, w});
+            }
+        }
+        return edges;
+    }
+
+    edges.reserve(static_cast<std::size_t>(p * n * (n - 1) / 2 * 1.05));
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    double log_q = std::log(1.0 - p);
+    long long v = 1;
+    long long w = -1;
+    while (v < n)
+    {
+        w += 1 + static_cast<long long>(std::floor(std::log(1.0 - uniform(rng)) / log_q));
+        while (w >= v && v < n)
+        {
+            w -= v;
+            ++v;
+        }
+        if (v < n)
+        {
+            edges.push_back({static_cast<int>(v), static_cast<int>(w)});
+        }
+    }
+    return edges;
+}
+
+// R-MAT / stochastic Kronecker graph with 2^scale vertices and
+// edge_factor * 2^scale edges. Each edge picks one quadrant of the
+// adjacency matrix per bit with probabilities a, b, c and 1 - a - b - c;
+// the defaults are the Graph500 ones. Labels are shuffled afterwards so
+// the hubs are not all at small ids. Self loops and repeated edges are
+// kept, as in Graph500.
+template <typename rng_type>
+std::vector<std::pair<int, int>> rmat_edges(int scale, int edge_factor, rng_type &rng, double a = 0.57,
+                                            double b = 0.19, double c = 0.19)
+{
+    if (scale < 0 || scale > 30 || edge_factor < 0 || a < 0 || b < 0 || c < 0 || a + b + c > 1.0)
+    {
+        throw std::invalid_argument("Invalid R-MAT parameters");
+    }
+    int n = 1 << scale;
+    std::size_t m = static_cast<std::size_t>(edge_factor) * n;
+
+    std::vector<int> label(n);
+    std::iota(label.begin(), label.end(), 0);
+    std::shuffle(label.begin(), label.end(), rng);
+
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(m);
+    for (std::size_t i = 0; i < m; ++i)
+    {
+        int u = 0;
+        int v = 0;
+        for (int bit = 0; bit < scale; ++bit)
+        {
+            double r = uniform(rng);
+            int row = r >= a + b ? 1 : 0;
+            int column = (r >= a && r < a + b) || r >= a + b + c ? 1 : 0;
+            u = (u << 1) | row;
+            v = (v << 1) | column;
+        }
+        edges.push_back({label[u], label[v]});
+    }
+    return edges;
+}
+
+// Barabasi-Albert preferential attachment: starts from a clique on
+// edges_per_vertex + 1 vertices, then each new vertex links to
+// edges_per_vertex distinct earlier vertices chosen with probability
+// proportional to degree. Sampling a uniform position in the list of all
+// edge endpoints so far gives that distribution in O(1).
+template <typename rng_type>
+std::vector<std::pair<int, int>> barabasi_albert_edges(int n, int edges_per_vertex, rng_type &rng)
+{
+    if (edges_per_vertex < 1 || n < edges_per_vertex + 1)
+    {
+        throw std::invalid_argument("Invalid Barabasi-Albert parameters");
+    }
+    int k = edges_per_vertex;
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(static_cast<std::size_t>(n) * k);
+    std::vector<int> endpoints;
+    endpoints.reserve(2 * static_cast<std::size_t>(n) * k);
+
+    for (int v = 0; v <= k; ++v)
+    {
+        for (int w = 0; w < v; ++w)
+        {
+            edges.push_back({v, w});
+            endpoints.push_back(v);
+            endpoints.push_back(w);
+        }
+    }
+
+    std::vector<int> chosen;
+    for (int v = k + 1; v < n; ++v)
+    {
+        chosen.clear();
+        std::uniform_int_distribution<std::size_t> pick(0, endpoints.size() - 1);
+        while (static_cast<int>(chosen.size()) < k)
+        {
+            int target = endpoints[pick(rng)];
+            if (std::find(chosen.begin(), chosen.end(), target) == chosen.end())
+            {
+                chosen.push_back(target);
+            }
+        }
+        for (int target : chosen)
+        {
+            edges.push_back({v, target});
+            endpoints.push_back(v);
+            endpoints.push_back(target);
+        }
+    }
+    return edges;
+}
+
+// rows x columns lattice; vertex (r, c) is r * columns + c.
+inline std::vector<std::pair<int, int>> grid_edges(int rows, int columns)
+{
+    std::vector<std::pair<int, int>> edges;
+    if (rows <= 0 || columns <= 0)
+    {
+        return edges;
+    }
+    edges.reserve(2 * static_cast<std::size_t>(rows) * columns);
+    for (int r = 0; r < rows; ++r)
+    {
+        for (int c = 0; c < columns; ++c)
+        {
+            int v = r * columns + c;
+            if (c + 1 < columns)
+            {
+                edges.push_back({v, v + 1});
+            }
+            if (r + 1 < rows)
+            {
+                edges.push_back({v, v + columns});
+            }
+        }
+    }
+    return edges;
+}
+
+// 0 - 1 - ... - (n - 1): the worst case for recursion depth and BFS rounds.
+inline std::vector<std::pair<int, int>> path_edges(int n)
+{
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(n > 0 ? n - 1 : 0);
+    for (int v = 0; v + 1 < n; ++v)
+    {
+        edges.push_back({v, v + 1});
+    }
+    return edges;
+}
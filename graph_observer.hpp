@@ -0,0 +1,58 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+// Receives structural change notifications from undirected_graph.
+class graph_observer
+{
+public:
+    virtual ~graph_observer() = default;
+
+    virtual void on_vertex_added(int vertex_id) { (void)vertex_id; }
+    virtual void on_edges_changed(int vertex_id) { (void)vertex_id; }
+};
+
+// Observers are bound to one graph object, so copies and moves of the graph
+// start with no observers attached.
+class observer_list
+{
+private:
+    std::vector<graph_observer *> observers;
+
+public:
+    observer_list() = default;
+    observer_list(const observer_list &) {}
+    observer_list(observer_list &&) noexcept {}
+    observer_list &operator=(const observer_list &) { return *this; }
+    observer_list &operator=(observer_list &&) noexcept { return *this; }
+
+    void attach(graph_observer *observer)
+    {
+        if (std::find(observers.begin(), observers.end(), observer) == observers.end())
+        {
+            observers.push_back(observer);
+        }
+    }
+
+    void detach(graph_observer *observer)
+    {
+        observers.erase(std::remove(observers.begin(), observers.end(), observer), observers.end());
+    }
+
+    void notify_vertex_added(int vertex_id) const
+    {
+        for (auto *observer : observers)
+        {
+            observer->on_vertex_added(vertex_id);
+        }
+    }
+
+    void notify_edges_changed(int vertex_id) const
+    {
+        for (auto *observer : observers)
+        {
+            observer->on_edges_changed(vertex_id);
+        }
+    }
+};
@@ -0,0 +1,278 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Splits the vertices of a graph into shards for sharded execution (see
+// distributed_components.hpp).
+//
+// Both partitioners are one-pass streaming heuristics: vertices arrive in id
+// order and each goes to the shard holding most of its already placed
+// neighbors, with a penalty for shard size. LDG (Stanton and Kliot) scales
+// the neighbor count by the shard's remaining capacity; Fennel (Tsourakakis
+// et al.) subtracts the marginal cost alpha * gamma * size^(gamma - 1). Both
+// see every adjacency list once, so they run in O(n * k + m). Locality of
+// the id order matters: reordering first (vertex_reordering.hpp) usually
+// lowers the cut.
+enum class partition_method
+{
+    ldg,
+    fennel
+};
+
+struct partition_options
+{
+    partition_method method = partition_method::fennel;
+    // No shard grows past slack * n / k vertices.
+    double slack = 1.1;
+    // Fennel only; 1.5 is the value recommended in the paper.
+    double gamma = 1.5;
+};
+
+struct graph_partition
+{
+    int shard_count = 0;
+    std::vector<int> shard_of;
+    std::vector<int> shard_sizes;
+};
+
+struct partition_quality
+{
+    long long arcs = 0;
+    // Arcs whose endpoints lie in different shards.
+    long long cut_arcs = 0;
+    double cut_fraction = 0;
+    // Largest shard relative to n / k; 1.0 is perfect balance.
+    double imbalance = 0;
+};
+
+template <typename graph>
+graph_partition partition_graph(const graph &gr, int shard_count, const partition_options &options = {})
+{
+    if (shard_count < 1)
+    {
+        throw std::invalid_argument("Invalid shard count");
+    }
+    if (!(options.slack >= 1.0) || !(options.gamma > 1.0))
+    {
+        throw std::invalid_argument("Invalid partition options");
+    }
+
+    int n = gr.vertex_count();
+    int k = shard_count;
+    graph_partition result;
+    result.shard_count = k;
+    result.shard_of.assign(n, -1);
+    result.shard_sizes.assign(k, 0);
+    if (n == 0)
+    {
+        return result;
+    }
+
+    double capacity = std::max(1.0, std::ceil(options.slack * n / k));
+    double alpha = 0;
+    if (options.method == partition_method::fennel)
+    {
+        // Fennel's alpha needs the edge count up front.
+        long long arcs = 0;
+        for (int v = 0; v < n; ++v)
+        {
+            gr.for_each_neighbor(v, [&](int)
+                                 { ++arcs; });
+        }
+        alpha = (arcs / 2.0) * std::pow(k, options.gamma - 1) / std::pow(n, options.gamma);
+    }
+
+    // Fennel's size penalty per shard, refreshed only when that shard grows.
+    std::vector<double> penalty(k, 0.0);
+    std::vector<int> placed_neighbors(k, 0);
+    std::vector<int> touched;
+    for (int v = 0; v < n; ++v)
+    {
+        gr.for_each_neighbor(v, [&](int u)
+                             {
+            int shard = result.shard_of[u];
+            if (shard >= 0 && u != v)
+            {
+                if (placed_neighbors[shard]++ == 0)
+                {
+                    touched.push_back(shard);
+                }
+            } });
+
+        int best = -1;
+        double best_score = -std::numeric_limits<double>::infinity();
+        for (int shard = 0; shard < k; ++shard)
+        {
+            double size = result.shard_sizes[shard];
+            if (size >= capacity)
+            {
+                continue;
+            }
+            double score = options.method == partition_method::ldg
+                               ? placed_neighbors[shard] * (1.0 - size / capacity)
+                               : placed_neighbors[shard] - penalty[shard];
+            // Ties go to the smaller shard, which also spreads vertices
+            // with no placed neighbors evenly.
+            if (best < 0 || score > best_score ||
+                (score == best_score && result.shard_sizes[shard] < result.shard_sizes[best]))
+            {
+                best = shard;
+                best_score = score;
+            }
+        }
+
+        result.shard_of[v] = best;
+        ++result.shard_sizes[best];
+        if (options.method == partition_method::fennel)
+        {
+            penalty[best] = alpha * options.gamma * std::pow(result.shard_sizes[best], options.gamma - 1);
+        }
+        for (int shard : touched)
+        {
+            placed_neighbors[shard] = 0;
+        }
+        touched.clear();
+    }
+    return result;
+}
+
+template <typename graph>
+partition_quality evaluate_partition(const graph &gr, const graph_partition &partition)
+{
+    partition_quality quality;
+    int n = gr.vertex_count();
+    for (int v = 0; v < n; ++v)
+    {
+        gr.for_each_neighbor(v, [&](int u)
+                             {
+            ++quality.arcs;
+            quality.cut_arcs += partition.shard_of[u] != partition.shard_of[v]; });
+    }
+    quality.cut_fraction = quality.arcs == 0 ? 0.0 : static_cast<double>(quality.cut_arcs) / quality.arcs;
+    int largest = 0;
+    for (int size : partition.shard_sizes)
+    {
+        largest = std::max(largest, size);
+    }
+    quality.imbalance = n == 0 ? 0.0 : largest / (static_cast<double>(n) / partition.shard_count);
+    return quality;
+}
+
+// One shard's slice of the graph. Local ids 0 .. owned_count - 1 are the
+// shard's own vertices in ascending global order; the rest are ghosts,
+// vertices of other shards that owned vertices link to. Only owned
+// vertices have adjacency here, so for_each_neighbor of a ghost is empty.
+struct graph_shard
+{
+    struct mirror
+    {
+        // Owned vertex, its holder shard and its local id there.
+        int local_id;
+        int shard;
+        int remote_id;
+    };
+
+    int shard_id = 0;
+    int shard_count = 0;
+    int owned_count = 0;
+    std::vector<int> global_ids;
+    std::vector<int> ghost_owners;
+    std::vector<std::size_t> offsets{0};
+    std::vector<int> targets;
+    // Owned vertices that other shards hold as ghosts, by local id.
+    std::vector<mirror> mirrors;
+
+    int vertex_count() const { return static_cast<int>(global_ids.size()); }
+    int ghost_count() const { return vertex_count() - owned_count; }
+    bool is_ghost(int local_id) const { return local_id >= owned_count; }
+    int global_id(int local_id) const { return global_ids[local_id]; }
+
+    int owner(int local_id) const
+    {
+        return is_ghost(local_id) ? ghost_owners[local_id - owned_count] : shard_id;
+    }
+
+    template <typename visitor>
+    void for_each_neighbor(int local_id, visitor &&visit) const
+    {
+        if (local_id < 0 || local_id >= vertex_count())
+        {
+            throw std::out_of_range("Invalid vertex ID");
+        }
+        if (is_ghost(local_id))
+        {
+            return;
+        }
+        for (std::size_t i = offsets[local_id]; i < offsets[local_id + 1]; ++i)
+        {
+            visit(targets[i]);
+        }
+    }
+};
+
+template <typename graph>
+std::vector<graph_shard> build_shards(const graph &gr, const graph_partition &partition)
+{
+    int n = gr.vertex_count();
+    int k = partition.shard_count;
+    if (static_cast<int>(partition.shard_of.size()) != n)
+    {
+        throw std::invalid_argument("Partition does not match vertex count");
+    }
+
+    std::vector<graph_shard> shards(k);
+    std::vector<int> rank(n);
+    for (int v = 0; v < n; ++v)
+    {
+        int shard = partition.shard_of[v];
+        if (shard < 0 || shard >= k)
+        {
+            throw std::invalid_argument("Invalid shard ID");
+        }
+        rank[v] = shards[shard].owned_count++;
+        shards[shard].global_ids.push_back(v);
+    }
+
+    // Ghost ids are handed out per shard; ghost_id[] is reset after each.
+    std::vector<int> ghost_id(n, -1);
+    for (int s = 0; s < k; ++s)
+    {
+        graph_shard &shard = shards[s];
+        shard.shard_id = s;
+        shard.shard_count = k;
+        for (int i = 0; i < shard.owned_count; ++i)
+        {
+            int v = shard.global_ids[i];
+            gr.for_each_neighbor(v, [&](int u)
+                                 {
+                int owner = partition.shard_of[u];
+                if (owner == s)
+                {
+                    shard.targets.push_back(rank[u]);
+                    return;
+                }
+                if (ghost_id[u] < 0)
+                {
+                    ghost_id[u] = static_cast<int>(shard.global_ids.size());
+                    shard.global_ids.push_back(u);
+                    shard.ghost_owners.push_back(owner);
+                }
+                shard.targets.push_back(ghost_id[u]); });
+            shard.offsets.push_back(shard.targets.size());
+        }
+
+        for (int i = shard.owned_count; i < shard.vertex_count(); ++i)
+        {
+            int u = shard.global_ids[i];
+            shards[partition.shard_of[u]].mirrors.push_back({rank[u], s, ghost_id[u]});
+            ghost_id[u] = -1;
+        }
+    }
+    return shards;
+}
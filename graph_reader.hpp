@@ -0,0 +1,543 @@
+#pragma once
+
+#include "csr_graph.hpp"
+#include "graph_builder.hpp"
+#include "posix_file.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Reads a file through one fixed buffer with read(2). Lines are handed out
+// as views into the buffer, so nothing is allocated per line; memory stays
+// at the buffer size unless a single line is longer than it.
+class chunked_reader
+{
+private:
+    file_descriptor fd;
+    std::string name;
+    std::vector<char> buffer;
+    std::size_t begin = 0;
+    std::size_t end = 0;
+    bool at_eof = false;
+    std::uint64_t consumed = 0;
+
+    // Moves unread bytes to the front and tops the buffer up. Returns false
+    // when no new bytes arrived.
+    bool refill()
+    {
+        if (at_eof)
+        {
+            return false;
+        }
+        if (begin > 0)
+        {
+            std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+            end -= begin;
+            begin = 0;
+        }
+        if (end == buffer.size())
+        {
+            buffer.resize(buffer.size() * 2);
+        }
+
+        ssize_t got;
+        do
+        {
+            got = ::read(fd.get(), buffer.data() + end, buffer.size() - end);
+        } while (got < 0 && errno == EINTR);
+
+        if (got < 0)
+        {
+            throw std::runtime_error("Cannot read file " + name);
+        }
+        if (got == 0)
+        {
+            at_eof = true;
+            return false;
+        }
+        end += static_cast<std::size_t>(got);
+        consumed += static_cast<std::uint64_t>(got);
+        return true;
+    }
+
+public:
+    explicit chunked_reader(const std::string &filename, std::size_t buffer_size = 1 << 20)
+        : fd(::open(filename.c_str(), O_RDONLY)), name(filename), buffer(buffer_size)
+    {
+        if (fd.get() < 0)
+        {
+            throw std::runtime_error("Cannot open file " + filename);
+        }
+#ifdef POSIX_FADV_SEQUENTIAL
+        ::posix_fadvise(fd.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    }
+
+    const std::string &filename() const { return name; }
+    std::uint64_t bytes_read() const { return consumed; }
+
+    // The view is valid until the next call.
+    bool next_line(std::string_view &line)
+    {
+        while (true)
+        {
+            const char *start = buffer.data() + begin;
+            const void *newline = std::memchr(start, '\n', end - begin);
+            if (newline)
+            {
+                std::size_t length = static_cast<const char *>(newline) - start;
+                line = std::string_view(start, length);
+                begin += length + 1;
+                return true;
+            }
+            if (!refill())
+            {
+                if (begin == end)
+                {
+                    return false;
+                }
+                line = std::string_view(buffer.data() + begin, end - begin);
+                begin = end;
+                return true;
+            }
+        }
+    }
+
+    // Character access for token-oriented formats; -1 at end of file.
+    int peek()
+    {
+        if (begin == end && !refill())
+        {
+            return -1;
+        }
+        return static_cast<unsigned char>(buffer[begin]);
+    }
+
+    int get()
+    {
+        int c = peek();
+        if (c >= 0)
+        {
+            ++begin;
+        }
+        return c;
+    }
+};
+
+struct edge_list_options
+{
+    // Map arbitrary (sparse, 64-bit) ids to dense vertex ids in order of
+    // first appearance. Without it ids are used as vertex ids directly.
+    bool remap_ids = false;
+    // Skip the first non-comment line (CSV column names).
+    bool has_header = false;
+    build_options build;
+};
+
+// SNAP / TSV / CSV edge lists: one "u v" pair per line, separated by any
+// mix of spaces, tabs, commas or semicolons. Extra columns are ignored and
+// lines starting with '#' or '%' are comments. Vertex payloads are the ids
+// as they appear in the file.
+inline csr_graph<std::int64_t> read_edge_list(const std::string &filename, const edge_list_options &options = {})
+{
+    chunked_reader reader(filename);
+
+    std::vector<std::pair<int, int>> edges;
+    std::vector<std::int64_t> original_ids;
+    std::unordered_map<std::int64_t, int> dense_ids;
+    std::int64_t max_id = -1;
+
+    auto is_separator = [](char c)
+    {
+        return c == ' ' || c == '\t' || c == ',' || c == ';' || c == '\r';
+    };
+
+    auto vertex_of = [&](std::int64_t id, std::uint64_t line_number) -> int
+    {
+        if (options.remap_ids)
+        {
+            auto [it, inserted] = dense_ids.try_emplace(id, static_cast<int>(original_ids.size()));
+            if (inserted)
+            {
+                original_ids.push_back(id);
+            }
+            return it->second;
+        }
+        if (id < 0 || id >= std::numeric_limits<int>::max())
+        {
+            throw std::runtime_error("Vertex id out of range on line " + std::to_string(line_number) + " of " + filename);
+        }
+        max_id = std::max(max_id, id);
+        return static_cast<int>(id);
+    };
+
+    std::string_view line;
+    std::uint64_t line_number = 0;
+    bool header_pending = options.has_header;
+
+    while (reader.next_line(line))
+    {
+        ++line_number;
+        const char *p = line.data();
+        const char *last = line.data() + line.size();
+        while (p != last && is_separator(*p))
+        {
+            ++p;
+        }
+        if (p == last || *p == '#' || *p == '%')
+        {
+            continue;
+        }
+        if (header_pending)
+        {
+            header_pending = false;
+            continue;
+        }
+
+        std::int64_t ids[2];
+        for (int k = 0; k < 2; ++k)
+        {
+            while (p != last && is_separator(*p))
+            {
+                ++p;
+            }
+            auto [next, error] = std::from_chars(p, last, ids[k]);
+            if (error != std::errc())
+            {
+                throw std::runtime_error("Invalid edge on line " + std::to_string(line_number) + " of " + filename);
+            }
+            p = next;
+        }
+
+        int u = vertex_of(ids[0], line_number);
+        int v = vertex_of(ids[1], line_number);
+        edges.push_back({u, v});
+    }
+
+    if (!options.remap_ids)
+    {
+        original_ids.resize(max_id + 1);
+        for (std::int64_t id = 0; id <= max_id; ++id)
+        {
+            original_ids[id] = id;
+        }
+    }
+
+    return build_csr_graph(std::move(original_ids), std::span<const std::pair<int, int>>(edges), options.build);
+}
+
+// Tokens of the DOT subset understood by read_dot.
+class dot_tokenizer
+{
+public:
+    enum class kind
+    {
+        end,
+        id,
+        symbol,
+        edge_op
+    };
+
+private:
+    chunked_reader &reader;
+    std::string text;
+    std::uint64_t line = 1;
+
+    [[noreturn]] void fail(const std::string &what) const
+    {
+        throw std::runtime_error(what + " on line " + std::to_string(line) + " of " + reader.filename());
+    }
+
+    void skip_space_and_comments()
+    {
+        while (true)
+        {
+            int c = reader.peek();
+            if (c == '\n')
+            {
+                ++line;
+                reader.get();
+            }
+            else if (c == ' ' || c == '\t' || c == '\r')
+            {
+                reader.get();
+            }
+            else if (c == '#')
+            {
+                while ((c = reader.peek()) >= 0 && c != '\n')
+                {
+                    reader.get();
+                }
+            }
+            else if (c == '/')
+            {
+                reader.get();
+                int next = reader.get();
+                if (next == '/')
+                {
+                    while ((c = reader.peek()) >= 0 && c != '\n')
+                    {
+                        reader.get();
+                    }
+                }
+                else if (next == '*')
+                {
+                    int previous = 0;
+                    while ((c = reader.get()) >= 0 && !(previous == '*' && c == '/'))
+                    {
+                        line += c == '\n';
+                        previous = c;
+                    }
+                }
+                else
+                {
+                    fail("Unexpected '/'");
+                }
+            }
+            else
+            {
+                return;
+            }
+        }
+    }
+
+    static bool is_id_char(int c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '.' || c >= 0x80;
+    }
+
+public:
+    explicit dot_tokenizer(chunked_reader &source) : reader(source) {}
+
+    // The text of the current token; valid until the next call.
+    const std::string &value() const { return text; }
+
+    [[noreturn]] void error(const std::string &what) const { fail(what); }
+
+    kind next()
+    {
+        skip_space_and_comments();
+        text.clear();
+
+        int c = reader.get();
+        if (c < 0)
+        {
+            return kind::end;
+        }
+
+        if (c == '"')
+        {
+            while (true)
+            {
+                c = reader.get();
+                if (c < 0)
+                {
+                    fail("Unterminated string");
+                }
+                if (c == '"')
+                {
+                    return kind::id;
+                }
+                if (c == '\\' && reader.peek() == '"')
+                {
+                    c = reader.get();
+                }
+                line += c == '\n';
+                text.push_back(static_cast<char>(c));
+            }
+        }
+
+        if (c == '-' && (reader.peek() == '-' || reader.peek() == '>'))
+        {
+            if (reader.get() == '>')
+            {
+                fail("Directed edges are not supported");
+            }
+            return kind::edge_op;
+        }
+
+        if (is_id_char(c) || c == '-')
+        {
+            text.push_back(static_cast<char>(c));
+            while (is_id_char(reader.peek()))
+            {
+                text.push_back(static_cast<char>(reader.get()));
+            }
+            return kind::id;
+        }
+
+        if (c == '{' || c == '}' || c == '[' || c == ']' || c == '=' || c == ';' || c == ',' || c == ':')
+        {
+            text.push_back(static_cast<char>(c));
+            return kind::symbol;
+        }
+
+        fail(std::string("Unexpected character '") + static_cast<char>(c) + "'");
+    }
+};
+
+// Undirected DOT subset: `[strict] graph [name] { ... }` with node
+// statements, `a -- b -- c` edge chains, attribute lists and graph/node/edge
+// defaults. Subgraphs and ports are rejected. Vertices are numbered in order
+// of first appearance; a vertex's payload is its `label` attribute if it has
+// one and its DOT id otherwise. This reads back what to_dot writes.
+inline csr_graph<std::string> read_dot(const std::string &filename, const build_options &options = {})
+{
+    chunked_reader reader(filename);
+    dot_tokenizer tokens(reader);
+    using kind = dot_tokenizer::kind;
+
+    std::unordered_map<std::string, int> ids;
+    std::vector<std::string> payloads;
+    std::vector<std::pair<int, int>> edges;
+    std::string name;
+
+    auto vertex_of = [&](const std::string &id_text)
+    {
+        auto it = ids.find(id_text);
+        if (it != ids.end())
+        {
+            return it->second;
+        }
+        int id = static_cast<int>(payloads.size());
+        ids.emplace(id_text, id);
+        payloads.push_back(id_text);
+        return id;
+    };
+
+    auto expect_symbol = [&](kind k, char symbol)
+    {
+        if (k != kind::symbol || tokens.value()[0] != symbol)
+        {
+            tokens.error(std::string("Expected '") + symbol + "'");
+        }
+    };
+
+    // Parses `[a=b, ...]` lists starting at the current token and returns
+    // the token after them. Labels are applied to `node` if it is >= 0.
+    auto attributes = [&](kind k, int node) -> kind
+    {
+        while (k == kind::symbol && tokens.value() == "[")
+        {
+            k = tokens.next();
+            while (!(k == kind::symbol && tokens.value() == "]"))
+            {
+                if (k != kind::id)
+                {
+                    tokens.error("Expected attribute name");
+                }
+                bool is_label = tokens.value() == "label";
+                expect_symbol(tokens.next(), '=');
+                if (tokens.next() != kind::id)
+                {
+                    tokens.error("Expected attribute value");
+                }
+                if (is_label && node >= 0)
+                {
+                    payloads[node] = tokens.value();
+                }
+                k = tokens.next();
+                if (k == kind::symbol && (tokens.value() == "," || tokens.value() == ";"))
+                {
+                    k = tokens.next();
+                }
+            }
+            k = tokens.next();
+        }
+        return k;
+    };
+
+    kind k = tokens.next();
+    if (k == kind::id && tokens.value() == "strict")
+    {
+        k = tokens.next();
+    }
+    if (k != kind::id || tokens.value() != "graph")
+    {
+        tokens.error(k == kind::id && tokens.value() == "digraph" ? "Directed graphs are not supported" : "Expected 'graph'");
+    }
+    k = tokens.next();
+    if (k == kind::id)
+    {
+        k = tokens.next();
+    }
+    expect_symbol(k, '{');
+
+    k = tokens.next();
+    while (!(k == kind::symbol && tokens.value() == "}"))
+    {
+        if (k == kind::end)
+        {
+            tokens.error("Unexpected end of file");
+        }
+        if (k == kind::symbol && tokens.value() == ";")
+        {
+            k = tokens.next();
+            continue;
+        }
+        if (k != kind::id)
+        {
+            tokens.error("Expected statement");
+        }
+        if (tokens.value() == "subgraph")
+        {
+            tokens.error("Subgraphs are not supported");
+        }
+
+        if (tokens.value() == "graph" || tokens.value() == "node" || tokens.value() == "edge")
+        {
+            k = attributes(tokens.next(), -1);
+            continue;
+        }
+
+        name = tokens.value();
+        k = tokens.next();
+
+        if (k == kind::symbol && tokens.value() == "=")
+        {
+            // Graph attribute `a = b`.
+            if (tokens.next() != kind::id)
+            {
+                tokens.error("Expected attribute value");
+            }
+            k = tokens.next();
+            continue;
+        }
+        if (k == kind::symbol && tokens.value() == ":")
+        {
+            tokens.error("Ports are not supported");
+        }
+
+        int first = vertex_of(name);
+        if (k != kind::edge_op)
+        {
+            k = attributes(k, first);
+            continue;
+        }
+
+        int previous = first;
+        while (k == kind::edge_op)
+        {
+            if (tokens.next() != kind::id)
+            {
+                tokens.error("Expected vertex after '--'");
+            }
+            int current = vertex_of(tokens.value());
+            edges.push_back({previous, current});
+            previous = current;
+            k = tokens.next();
+        }
+        k = attributes(k, -1);
+    }
+
+    return build_csr_graph(std::move(payloads), std::span<const std::pair<int, int>>(edges), options);
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "csr_graph.hpp"
+#include "dynamic_bitset.hpp"
+#include "undirected_graph.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// How hybrid_graph stores neighbor sets. `automatic` decides per vertex:
+// a bitset row when it is smaller than the sorted id list, i.e. above
+// n / 32 neighbors.
+enum class adjacency_layout
+{
+    automatic,
+    sparse,
+    dense
+};
+
+// Immutable snapshot for dense graphs. Each vertex keeps its neighbors
+// either as a row of n bits or as a sorted id list. Rows give popcount
+// degrees, word-wise AND/OR set operations, and traversals that expand a
+// dense vertex 64 candidates at a time against the visited bitset.
+//
+// Neighbors are a set in both layouts, so parallel edges are merged.
+// Neighbors come out in ascending order whichever layout a vertex uses.
+template <typename t_vertex>
+class hybrid_graph
+{
+private:
+    struct storage_arrays
+    {
+        std::vector<t_vertex> payloads;
+        // row_of[v] is v's row in `rows`, or -1 when v is stored sparse.
+        std::vector<int> row_of;
+        std::vector<std::uint64_t> rows;
+        std::vector<std::size_t> offsets;
+        std::vector<int> targets;
+        std::vector<int> degrees;
+        std::size_t words_per_row = 0;
+        std::size_t arcs = 0;
+    };
+
+    std::shared_ptr<const storage_arrays> storage;
+
+    void check_vertex(int vertex_id) const;
+    const std::uint64_t *row(int vertex_id) const;
+
+    template <typename neighbor_source>
+    void build(int n, neighbor_source &&source, std::vector<t_vertex> vertex_payloads, adjacency_layout layout);
+
+    // Marks the unvisited neighbors of v as visited and calls fresh(u) for
+    // each of them.
+    template <typename callback>
+    void expand(int vertex_id, dynamic_bitset &visited, callback &&fresh) const;
+
+public:
+    using edge_type = std::monostate;
+
+    hybrid_graph();
+    explicit hybrid_graph(const csr_graph<t_vertex> &graph, adjacency_layout layout = adjacency_layout::automatic);
+    explicit hybrid_graph(const undirected_graph<t_vertex> &graph,
+                          adjacency_layout layout = adjacency_layout::automatic);
+
+    static hybrid_graph from_edge_list(std::vector<t_vertex> vertex_payloads,
+                                       const std::vector<std::pair<int, int>> &edges,
+                                       adjacency_layout layout = adjacency_layout::automatic);
+
+    int vertex_count() const;
+    std::size_t arc_count() const;
+    int degree(int vertex_id) const;
+    bool is_dense(int vertex_id) const;
+    int dense_vertex_count() const;
+
+    bool has_edge(int u, int v) const;
+
+    template <typename visitor>
+    void for_each_neighbor(int vertex_id, visitor &&visit) const;
+
+    // |N(u) & N(v)|.
+    int common_neighbor_count(int u, int v) const;
+    // ORs, or ANDs, the neighbor set of v into a bitset of vertex_count() bits.
+    void unite_neighbors(int vertex_id, dynamic_bitset &set) const;
+    void intersect_neighbors(int vertex_id, dynamic_bitset &set) const;
+
+    const t_vertex &vertex_data(int vertex_id) const;
+
+    // Rows, lists and offsets, without payloads.
+    std::size_t adjacency_bytes() const;
+
+    // Hop counts from `source`; -1 where unreachable.
+    std::vector<int> bfs_distances(int source) const;
+
+    array_sequence<list_sequence<int>> find_connected_components() const;
+    std::vector<int> find_component_labels() const;
+};
+
+#include "hybrid_graph.tpp"
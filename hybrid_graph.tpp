@@ -0,0 +1,415 @@
+#include "hybrid_graph.hpp"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+template <typename t_vertex>
+void hybrid_graph<t_vertex>::check_vertex(int vertex_id) const
+{
+    if (vertex_id < 0 || vertex_id >= vertex_count())
+    {
+        throw std::out_of_range("Invalid vertex ID");
+    }
+}
+
+template <typename t_vertex>
+const std::uint64_t *hybrid_graph<t_vertex>::row(int vertex_id) const
+{
+    return storage->rows.data() + static_cast<std::size_t>(storage->row_of[vertex_id]) * storage->words_per_row;
+}
+
+// `source(v, list)` fills `list` with the neighbors of v.
+template <typename t_vertex>
+template <typename neighbor_source>
+void hybrid_graph<t_vertex>::build(int n, neighbor_source &&source, std::vector<t_vertex> vertex_payloads,
+                                   adjacency_layout layout)
+{
+    auto arrays = std::make_shared<storage_arrays>();
+    arrays->payloads = std::move(vertex_payloads);
+    arrays->words_per_row = (static_cast<std::size_t>(n) + 63) / 64;
+    arrays->row_of.assign(n, -1);
+    arrays->degrees.assign(n, 0);
+    arrays->offsets.reserve(n + 1);
+    arrays->offsets.push_back(0);
+
+    int rows = 0;
+    std::vector<int> list;
+    for (int v = 0; v < n; ++v)
+    {
+        list.clear();
+        source(v, list);
+        for (int u : list)
+        {
+            if (u < 0 || u >= n)
+            {
+                throw std::out_of_range("Invalid vertex ID");
+            }
+        }
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+        arrays->degrees[v] = static_cast<int>(list.size());
+        arrays->arcs += list.size();
+
+        bool dense = layout == adjacency_layout::dense ||
+                     (layout == adjacency_layout::automatic &&
+                      list.size() * sizeof(int) > arrays->words_per_row * sizeof(std::uint64_t));
+        if (dense)
+        {
+            arrays->row_of[v] = rows++;
+            arrays->rows.resize(static_cast<std::size_t>(rows) * arrays->words_per_row, 0);
+            std::uint64_t *bits = arrays->rows.data() + static_cast<std::size_t>(rows - 1) * arrays->words_per_row;
+            for (int u : list)
+            {
+                bits[u >> 6] |= std::uint64_t{1} << (u & 63);
+            }
+        }
+        else
+        {
+            arrays->targets.insert(arrays->targets.end(), list.begin(), list.end());
+        }
+        arrays->offsets.push_back(arrays->targets.size());
+    }
+    storage = std::move(arrays);
+}
+
+template <typename t_vertex>
+hybrid_graph<t_vertex>::hybrid_graph()
+{
+    auto arrays = std::make_shared<storage_arrays>();
+    arrays->offsets.push_back(0);
+    storage = std::move(arrays);
+}
+
+template <typename t_vertex>
+hybrid_graph<t_vertex>::hybrid_graph(const csr_graph<t_vertex> &graph, adjacency_layout layout)
+{
+    std::span<const t_vertex> payloads = graph.payload_array();
+    build(graph.vertex_count(), [&](int v, std::vector<int> &list)
+          {
+        std::span<const int> neighbors = graph.neighbors(v);
+        list.assign(neighbors.begin(), neighbors.end()); },
+          std::vector<t_vertex>(payloads.begin(), payloads.end()), layout);
+}
+
+template <typename t_vertex>
+hybrid_graph<t_vertex>::hybrid_graph(const undirected_graph<t_vertex> &graph, adjacency_layout layout)
+{
+    int n = graph.vertex_count();
+    std::vector<t_vertex> payloads;
+    payloads.reserve(n);
+    for (int v = 0; v < n; ++v)
+    {
+        payloads.push_back(graph.vertex_data(v));
+    }
+    build(n, [&](int v, std::vector<int> &list)
+          { graph.for_each_neighbor(v, [&](int u)
+                                    { list.push_back(u); }); },
+          std::move(payloads), layout);
+}
+
+template <typename t_vertex>
+hybrid_graph<t_vertex> hybrid_graph<t_vertex>::from_edge_list(std::vector<t_vertex> vertex_payloads,
+                                                              const std::vector<std::pair<int, int>> &edges,
+                                                              adjacency_layout layout)
+{
+    return hybrid_graph(csr_graph<t_vertex>::from_edge_list(std::move(vertex_payloads), edges), layout);
+}
+
+template <typename t_vertex>
+int hybrid_graph<t_vertex>::vertex_count() const
+{
+    return static_cast<int>(storage->payloads.size());
+}
+
+template <typename t_vertex>
+std::size_t hybrid_graph<t_vertex>::arc_count() const
+{
+    return storage->arcs;
+}
+
+// Taken from the stored degrees rather than a popcount of the row; both
+// agree, and this is O(1).
+template <typename t_vertex>
+int hybrid_graph<t_vertex>::degree(int vertex_id) const
+{
+    check_vertex(vertex_id);
+    return storage->degrees[vertex_id];
+}
+
+template <typename t_vertex>
+bool hybrid_graph<t_vertex>::is_dense(int vertex_id) const
+{
+    check_vertex(vertex_id);
+    return storage->row_of[vertex_id] >= 0;
+}
+
+template <typename t_vertex>
+int hybrid_graph<t_vertex>::dense_vertex_count() const
+{
+    return storage->words_per_row == 0 ? 0 : static_cast<int>(storage->rows.size() / storage->words_per_row);
+}
+
+template <typename t_vertex>
+bool hybrid_graph<t_vertex>::has_edge(int u, int v) const
+{
+    check_vertex(u);
+    check_vertex(v);
+    if (storage->row_of[u] >= 0)
+    {
+        return (row(u)[v >> 6] >> (v & 63)) & 1u;
+    }
+    auto first = storage->targets.begin() + storage->offsets[u];
+    auto last = storage->targets.begin() + storage->offsets[u + 1];
+    return std::binary_search(first, last, v);
+}
+
+template <typename t_vertex>
+template <typename visitor>
+void hybrid_graph<t_vertex>::for_each_neighbor(int vertex_id, visitor &&visit) const
+{
+    check_vertex(vertex_id);
+    if (storage->row_of[vertex_id] >= 0)
+    {
+        const std::uint64_t *bits = row(vertex_id);
+        for (std::size_t w = 0; w < storage->words_per_row; ++w)
+        {
+            for (std::uint64_t word = bits[w]; word != 0; word &= word - 1)
+            {
+                visit(static_cast<int>(w * 64 + std::countr_zero(word)));
+            }
+        }
+        return;
+    }
+    for (std::size_t i = storage->offsets[vertex_id]; i < storage->offsets[vertex_id + 1]; ++i)
+    {
+        visit(storage->targets[i]);
+    }
+}
+
+template <typename t_vertex>
+int hybrid_graph<t_vertex>::common_neighbor_count(int u, int v) const
+{
+    check_vertex(u);
+    check_vertex(v);
+    bool dense_u = storage->row_of[u] >= 0;
+    bool dense_v = storage->row_of[v] >= 0;
+    if (dense_u && dense_v)
+    {
+        // Plain word loop; the compiler vectorizes it.
+        const std::uint64_t *a = row(u);
+        const std::uint64_t *b = row(v);
+        int count = 0;
+        for (std::size_t w = 0; w < storage->words_per_row; ++w)
+        {
+            count += std::popcount(a[w] & b[w]);
+        }
+        return count;
+    }
+    if (dense_u || dense_v)
+    {
+        int dense = dense_u ? u : v;
+        int sparse = dense_u ? v : u;
+        int count = 0;
+        for_each_neighbor(sparse, [&](int w)
+                          { count += has_edge(dense, w) ? 1 : 0; });
+        return count;
+    }
+    auto a = storage->targets.begin() + storage->offsets[u];
+    auto a_end = storage->targets.begin() + storage->offsets[u + 1];
+    auto b = storage->targets.begin() + storage->offsets[v];
+    auto b_end = storage->targets.begin() + storage->offsets[v + 1];
+    int count = 0;
+    while (a != a_end && b != b_end)
+    {
+        if (*a < *b)
+        {
+            ++a;
+        }
+        else if (*b < *a)
+        {
+            ++b;
+        }
+        else
+        {
+            ++count;
+            ++a;
+            ++b;
+        }
+    }
+    return count;
+}
+
+template <typename t_vertex>
+void hybrid_graph<t_vertex>::unite_neighbors(int vertex_id, dynamic_bitset &set) const
+{
+    check_vertex(vertex_id);
+    if (set.size() != static_cast<std::size_t>(vertex_count()))
+    {
+        throw std::invalid_argument("Bitset size does not match vertex count");
+    }
+    if (storage->row_of[vertex_id] >= 0)
+    {
+        const std::uint64_t *bits = row(vertex_id);
+        std::uint64_t *out = set.data();
+        for (std::size_t w = 0; w < storage->words_per_row; ++w)
+        {
+            out[w] |= bits[w];
+        }
+        return;
+    }
+    for_each_neighbor(vertex_id, [&](int u)
+                      { set.set(u); });
+}
+
+template <typename t_vertex>
+void hybrid_graph<t_vertex>::intersect_neighbors(int vertex_id, dynamic_bitset &set) const
+{
+    check_vertex(vertex_id);
+    if (set.size() != static_cast<std::size_t>(vertex_count()))
+    {
+        throw std::invalid_argument("Bitset size does not match vertex count");
+    }
+    std::uint64_t *out = set.data();
+    if (storage->row_of[vertex_id] >= 0)
+    {
+        const std::uint64_t *bits = row(vertex_id);
+        for (std::size_t w = 0; w < storage->words_per_row; ++w)
+        {
+            out[w] &= bits[w];
+        }
+        return;
+    }
+    // Keep only the listed bits that were already set.
+    std::size_t next = storage->offsets[vertex_id];
+    std::size_t end = storage->offsets[vertex_id + 1];
+    for (std::size_t w = 0; w < storage->words_per_row; ++w)
+    {
+        std::uint64_t mask = 0;
+        for (; next < end && static_cast<std::size_t>(storage->targets[next]) < (w + 1) * 64; ++next)
+        {
+            mask |= std::uint64_t{1} << (storage->targets[next] & 63);
+        }
+        out[w] &= mask;
+    }
+}
+
+template <typename t_vertex>
+template <typename callback>
+void hybrid_graph<t_vertex>::expand(int vertex_id, dynamic_bitset &visited, callback &&fresh) const
+{
+    if (storage->row_of[vertex_id] >= 0)
+    {
+        const std::uint64_t *bits = row(vertex_id);
+        std::uint64_t *seen = visited.data();
+        for (std::size_t w = 0; w < storage->words_per_row; ++w)
+        {
+            std::uint64_t word = bits[w] & ~seen[w];
+            seen[w] |= word;
+            for (; word != 0; word &= word - 1)
+            {
+                fresh(static_cast<int>(w * 64 + std::countr_zero(word)));
+            }
+        }
+        return;
+    }
+    for (std::size_t i = storage->offsets[vertex_id]; i < storage->offsets[vertex_id + 1]; ++i)
+    {
+        int u = storage->targets[i];
+        if (!visited.test_and_set(u))
+        {
+            fresh(u);
+        }
+    }
+}
+
+template <typename t_vertex>
+const t_vertex &hybrid_graph<t_vertex>::vertex_data(int vertex_id) const
+{
+    check_vertex(vertex_id);
+    return storage->payloads[vertex_id];
+}
+
+template <typename t_vertex>
+std::size_t hybrid_graph<t_vertex>::adjacency_bytes() const
+{
+    return storage->rows.size() * sizeof(std::uint64_t) + storage->targets.size() * sizeof(int) +
+           storage->offsets.size() * sizeof(std::size_t) + storage->row_of.size() * sizeof(int) +
+           storage->degrees.size() * sizeof(int);
+}
+
+template <typename t_vertex>
+std::vector<int> hybrid_graph<t_vertex>::bfs_distances(int source) const
+{
+    check_vertex(source);
+    std::vector<int> distances(vertex_count(), -1);
+    dynamic_bitset visited(vertex_count());
+    std::vector<int> frontier{source};
+    std::vector<int> next;
+    visited.set(source);
+    distances[source] = 0;
+
+    for (int depth = 1; !frontier.empty(); ++depth)
+    {
+        next.clear();
+        for (int v : frontier)
+        {
+            expand(v, visited, [&](int u)
+                   {
+                distances[u] = depth;
+                next.push_back(u); });
+        }
+        frontier.swap(next);
+    }
+    return distances;
+}
+
+template <typename t_vertex>
+array_sequence<list_sequence<int>> hybrid_graph<t_vertex>::find_connected_components() const
+{
+    std::vector<int> labels = find_component_labels();
+    int count = labels.empty() ? 0 : *std::max_element(labels.begin(), labels.end()) + 1;
+    std::vector<list_sequence<int>> members(count);
+    for (int v = 0; v < vertex_count(); ++v)
+    {
+        members[labels[v]].append_element(v);
+    }
+
+    array_sequence<list_sequence<int>> components;
+    for (auto &component : members)
+    {
+        components.append_element(std::move(component));
+    }
+    return components;
+}
+
+// Same numbering as component_labels(): in order of smallest vertex.
+template <typename t_vertex>
+std::vector<int> hybrid_graph<t_vertex>::find_component_labels() const
+{
+    int n = vertex_count();
+    std::vector<int> labels(n, -1);
+    dynamic_bitset visited(n);
+    std::vector<int> stack;
+    int next_label = 0;
+
+    for (int root = 0; root < n; ++root)
+    {
+        if (visited.test_and_set(root))
+        {
+            continue;
+        }
+        labels[root] = next_label;
+        stack.push_back(root);
+        while (!stack.empty())
+        {
+            int v = stack.back();
+            stack.pop_back();
+            expand(v, visited, [&](int u)
+                   {
+                labels[u] = next_label;
+                stack.push_back(u); });
+        }
+        ++next_label;
+    }
+    return labels;
+}
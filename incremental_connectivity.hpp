@@ -0,0 +1,74 @@
+#pragma once
+
+#include "undirected_graph.hpp"
+#include "concurrent_disjoint_set.hpp"
+#include "graph_observer.hpp"
+
+// Insert-only connectivity kept in sync with an undirected_graph. Every
+// set_edge_generator call unites the vertex with its new neighbors; edges a
+// replaced generator no longer reports are NOT removed.
+//
+// insert_edge, connected and component_of may be called from many threads
+// at once. Graph mutations (add_vertex, set_edge_generator) still need the
+// same external synchronization as the graph itself.
+template <typename t_vertex, typename t_edge = std::monostate>
+class incremental_connectivity : public graph_observer
+{
+private:
+    undirected_graph<t_vertex, t_edge> *graph;
+    concurrent_disjoint_set forest;
+
+    void unite_neighbors(int vertex_id)
+    {
+        graph->for_each_neighbor(vertex_id, [&](int u)
+                                 { forest.unite(vertex_id, u); });
+    }
+
+public:
+    explicit incremental_connectivity(undirected_graph<t_vertex, t_edge> &source)
+        : graph(&source), forest(source.vertex_count())
+    {
+        for (int v = 0; v < source.vertex_count(); ++v)
+        {
+            unite_neighbors(v);
+        }
+        graph->attach_observer(this);
+    }
+
+    incremental_connectivity(const incremental_connectivity &) = delete;
+    incremental_connectivity &operator=(const incremental_connectivity &) = delete;
+
+    ~incremental_connectivity() override
+    {
+        graph->detach_observer(this);
+    }
+
+    void on_vertex_added(int vertex_id) override
+    {
+        forest.grow(vertex_id + 1);
+    }
+
+    void on_edges_changed(int vertex_id) override
+    {
+        unite_neighbors(vertex_id);
+    }
+
+    // Records an edge that arrived outside of the graph's generators.
+    bool insert_edge(int u, int v)
+    {
+        return forest.unite(u, v);
+    }
+
+    bool connected(int u, int v) const
+    {
+        return forest.same_set(u, v);
+    }
+
+    // Representative vertex of v's component. It may change as components
+    // merge, but two vertices have the same representative at a given moment
+    // exactly when they are connected.
+    int component_of(int v) const
+    {
+        return forest.find(v);
+    }
+};
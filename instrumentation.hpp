@@ -0,0 +1,447 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Operation counters and phase timings for the graph algorithms.
+//
+// Built with GRAPH_INSTRUMENTATION defined (cmake -DGRAPH_INSTRUMENTATION=ON),
+// GRAPH_COUNT and GRAPH_PHASE record into process-wide totals that
+// instrumentation::snapshot() returns. Without it both macros expand to
+// nothing and their arguments are not evaluated, so the hot paths compile
+// exactly as before. perf_counter_group works in either build.
+//
+// The definition must be the same in every translation unit of a program,
+// since it changes the bodies of the graph templates.
+
+#if defined(GRAPH_INSTRUMENTATION)
+#define GRAPH_INSTRUMENTATION_CONCAT_IMPL(a, b) a##b
+#define GRAPH_INSTRUMENTATION_CONCAT(a, b) GRAPH_INSTRUMENTATION_CONCAT_IMPL(a, b)
+#define GRAPH_COUNT(name, amount) ::instrumentation::add(::instrumentation::counter::name, (amount))
+#define GRAPH_PHASE(name) \
+    ::instrumentation::phase_timer GRAPH_INSTRUMENTATION_CONCAT(graph_phase_timer_, __LINE__)(name)
+#else
+#define GRAPH_COUNT(name, amount) ((void)0)
+#define GRAPH_PHASE(name) ((void)0)
+#endif
+
+namespace instrumentation
+{
+#if defined(GRAPH_INSTRUMENTATION)
+    inline constexpr bool enabled = true;
+#else
+    inline constexpr bool enabled = false;
+#endif
+
+    enum class counter : int
+    {
+        generator_calls,
+        edges_scanned,
+        vertices_visited,
+        allocations,
+        bytes_allocated,
+        cache_hits,
+        cache_misses,
+        count
+    };
+
+    inline constexpr int counter_count = static_cast<int>(counter::count);
+
+    inline const char *counter_name(counter c)
+    {
+        static constexpr const char *names[counter_count] = {
+            "generator_calls", "edges_scanned", "vertices_visited", "allocations",
+            "bytes_allocated", "cache_hits", "cache_misses"};
+        return names[static_cast<int>(c)];
+    }
+
+    // -1 marks an event the kernel would not count (no perf support, not
+    // permitted, or not present on this CPU).
+    struct hardware_counters
+    {
+        long long cycles = -1;
+        long long instructions = -1;
+        long long cache_misses = -1;
+        long long branch_misses = -1;
+
+        bool available() const
+        {
+            return cycles >= 0 || instructions >= 0 || cache_misses >= 0 || branch_misses >= 0;
+        }
+
+        hardware_counters &operator+=(const hardware_counters &other)
+        {
+            auto accumulate = [](long long &total, long long value)
+            {
+                if (value >= 0)
+                {
+                    total = total < 0 ? value : total + value;
+                }
+            };
+            accumulate(cycles, other.cycles);
+            accumulate(instructions, other.instructions);
+            accumulate(cache_misses, other.cache_misses);
+            accumulate(branch_misses, other.branch_misses);
+            return *this;
+        }
+    };
+
+    // Hardware events of the calling thread, counted in user space between
+    // start() and stop(). Opening may fail (non-Linux, containers,
+    // perf_event_paranoid); the group then reports every event as -1
+    // instead of throwing, so callers can use it unconditionally.
+    class perf_counter_group
+    {
+        static constexpr int event_count = 4;
+        int descriptors[event_count] = {-1, -1, -1, -1};
+
+#if defined(__linux__)
+        static int open_event(std::uint64_t config, int group)
+        {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = config;
+            attr.disabled = group == -1 ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+        }
+#endif
+
+        long long value(int index) const
+        {
+#if defined(__linux__)
+            std::uint64_t count = 0;
+            if (descriptors[index] >= 0 && ::read(descriptors[index], &count, sizeof(count)) == sizeof(count))
+            {
+                return static_cast<long long>(count);
+            }
+#else
+            (void)index;
+#endif
+            return -1;
+        }
+
+    public:
+        perf_counter_group()
+        {
+#if defined(__linux__)
+            // Cycles lead the group, so all events cover the same interval.
+            static constexpr std::uint64_t configs[event_count] = {
+                PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+                PERF_COUNT_HW_BRANCH_MISSES};
+            descriptors[0] = open_event(configs[0], -1);
+            if (descriptors[0] < 0)
+            {
+                return;
+            }
+            for (int i = 1; i < event_count; ++i)
+            {
+                descriptors[i] = open_event(configs[i], descriptors[0]);
+            }
+#endif
+        }
+
+        ~perf_counter_group()
+        {
+#if defined(__linux__)
+            for (int fd : descriptors)
+            {
+                if (fd >= 0)
+                {
+                    close(fd);
+                }
+            }
+#endif
+        }
+
+        perf_counter_group(const perf_counter_group &) = delete;
+        perf_counter_group &operator=(const perf_counter_group &) = delete;
+
+        bool available() const { return descriptors[0] >= 0; }
+
+        void start()
+        {
+#if defined(__linux__)
+            if (available())
+            {
+                ioctl(descriptors[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                ioctl(descriptors[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+#endif
+        }
+
+        void stop()
+        {
+#if defined(__linux__)
+            if (available())
+            {
+                ioctl(descriptors[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            }
+#endif
+        }
+
+        hardware_counters read() const
+        {
+            hardware_counters result;
+            result.cycles = value(0);
+            result.instructions = value(1);
+            result.cache_misses = value(2);
+            result.branch_misses = value(3);
+            return result;
+        }
+    };
+
+    struct phase_record
+    {
+        std::string name;
+        long long calls = 0;
+        double milliseconds = 0;
+        hardware_counters hardware;
+    };
+
+    struct stats
+    {
+        std::array<long long, counter_count> counters{};
+        std::vector<phase_record> phases;
+
+        long long get(counter c) const { return counters[static_cast<int>(c)]; }
+
+        const phase_record *phase(std::string_view name) const
+        {
+            for (const phase_record &p : phases)
+            {
+                if (p.name == name)
+                {
+                    return &p;
+                }
+            }
+            return nullptr;
+        }
+
+        std::string to_json() const
+        {
+            auto number = [](double value)
+            {
+                char buffer[32];
+                int length = std::snprintf(buffer, sizeof(buffer), "%.6g", value);
+                return std::string(buffer, length);
+            };
+            auto hardware = [](const hardware_counters &h)
+            {
+                std::pair<const char *, long long> fields[] = {{"cycles", h.cycles},
+                                                               {"instructions", h.instructions},
+                                                               {"cache_misses", h.cache_misses},
+                                                               {"branch_misses", h.branch_misses}};
+                std::string out = "{";
+                for (std::size_t i = 0; i < std::size(fields); ++i)
+                {
+                    out += i == 0 ? "\"" : ", \"";
+                    out += fields[i].first;
+                    out += "\": ";
+                    out += fields[i].second < 0 ? "null" : std::to_string(fields[i].second);
+                }
+                return out + "}";
+            };
+
+            std::string out = "{\n  \"enabled\": ";
+            out += enabled ? "true" : "false";
+            out += ",\n  \"counters\": {";
+            for (int i = 0; i < counter_count; ++i)
+            {
+                out += i == 0 ? "\n    \"" : ",\n    \"";
+                out += counter_name(static_cast<counter>(i));
+                out += "\": " + std::to_string(counters[i]);
+            }
+            out += "\n  },\n  \"phases\": [";
+            for (std::size_t i = 0; i < phases.size(); ++i)
+            {
+                const phase_record &p = phases[i];
+                // Phase names are identifiers from the source, no escaping
+                // needed.
+                out += i == 0 ? "\n    {" : ",\n    {";
+                out += "\"name\": \"" + p.name + "\", \"calls\": " + std::to_string(p.calls);
+                out += ", \"milliseconds\": " + number(p.milliseconds);
+                out += ", \"hardware\": " + hardware(p.hardware) + "}";
+            }
+            out += phases.empty() ? "]\n}\n" : "\n  ]\n}\n";
+            return out;
+        }
+    };
+
+    // Process-wide totals. Counters are relaxed atomics bumped once per
+    // call site hit; phases are few and coarse, so a mutex is enough.
+    struct registry
+    {
+        std::array<std::atomic<long long>, counter_count> counters{};
+        std::mutex phase_mutex;
+        std::vector<phase_record> phases;
+        std::atomic<bool> hardware = false;
+
+        static registry &instance()
+        {
+            static registry state;
+            return state;
+        }
+    };
+
+    inline void add(counter c, long long amount)
+    {
+        registry::instance().counters[static_cast<int>(c)].fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    // Opens perf counters around every phase from now on. Costs a few
+    // syscalls per phase, so it is off by default.
+    inline void set_hardware_counting(bool on)
+    {
+        registry::instance().hardware.store(on, std::memory_order_relaxed);
+    }
+
+    inline void record_phase(const char *name, double milliseconds, const hardware_counters &hardware)
+    {
+        registry &state = registry::instance();
+        std::lock_guard<std::mutex> lock(state.phase_mutex);
+        for (phase_record &p : state.phases)
+        {
+            if (p.name == name)
+            {
+                ++p.calls;
+                p.milliseconds += milliseconds;
+                p.hardware += hardware;
+                return;
+            }
+        }
+        state.phases.push_back({name, 1, milliseconds, hardware});
+    }
+
+    inline stats snapshot()
+    {
+        registry &state = registry::instance();
+        stats result;
+        for (int i = 0; i < counter_count; ++i)
+        {
+            result.counters[i] = state.counters[i].load(std::memory_order_relaxed);
+        }
+        std::lock_guard<std::mutex> lock(state.phase_mutex);
+        result.phases = state.phases;
+        return result;
+    }
+
+    inline void reset()
+    {
+        registry &state = registry::instance();
+        for (auto &c : state.counters)
+        {
+            c.store(0, std::memory_order_relaxed);
+        }
+        std::lock_guard<std::mutex> lock(state.phase_mutex);
+        state.phases.clear();
+    }
+
+    // Times its scope as one call of the named phase.
+    class phase_timer
+    {
+        const char *name;
+        std::optional<perf_counter_group> hardware;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        explicit phase_timer(const char *phase_name) : name(phase_name)
+        {
+            if (registry::instance().hardware.load(std::memory_order_relaxed))
+            {
+                hardware.emplace();
+                hardware->start();
+            }
+            start = std::chrono::steady_clock::now();
+        }
+
+        ~phase_timer()
+        {
+            auto end = std::chrono::steady_clock::now();
+            hardware_counters events;
+            if (hardware)
+            {
+                hardware->stop();
+                events = hardware->read();
+            }
+            record_phase(name, std::chrono::duration<double, std::milli>(end - start).count(), events);
+        }
+
+        phase_timer(const phase_timer &) = delete;
+        phase_timer &operator=(const phase_timer &) = delete;
+    };
+
+    // Forwards to `upstream` and counts allocations and bytes, both in its
+    // own totals and, when instrumentation is on, in the global counters.
+    class counting_resource : public std::pmr::memory_resource
+    {
+        std::pmr::memory_resource *upstream;
+        std::atomic<long long> allocation_count = 0;
+        std::atomic<long long> byte_count = 0;
+
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            void *p = upstream->allocate(bytes, alignment);
+            allocation_count.fetch_add(1, std::memory_order_relaxed);
+            byte_count.fetch_add(static_cast<long long>(bytes), std::memory_order_relaxed);
+            GRAPH_COUNT(allocations, 1);
+            GRAPH_COUNT(bytes_allocated, static_cast<long long>(bytes));
+            return p;
+        }
+
+        void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override
+        {
+            upstream->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+        {
+            return this == &other;
+        }
+
+    public:
+        explicit counting_resource(std::pmr::memory_resource *upstream_resource = std::pmr::get_default_resource())
+            : upstream(upstream_resource)
+        {
+        }
+
+        long long allocations() const { return allocation_count.load(std::memory_order_relaxed); }
+        long long bytes() const { return byte_count.load(std::memory_order_relaxed); }
+    };
+
+    // Where algorithm scratch should come from: the default resource, seen
+    // through a counting_resource when instrumentation is on.
+    inline std::pmr::memory_resource *scratch_resource()
+    {
+        if constexpr (enabled)
+        {
+            static counting_resource counted(std::pmr::get_default_resource());
+            return &counted;
+        }
+        else
+        {
+            return std::pmr::get_default_resource();
+        }
+    }
+}
@@ -0,0 +1,127 @@
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include "graph_reader.hpp"
+#include "dot_helper.hpp"
+
+template <typename F>
+double time_ms(F &&f)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+}
+
+// The DOT writer this benchmark compares against: an ostringstream per
+// document and a std::string per label.
+template <typename graph>
+std::string ostream_to_dot(const graph &gr)
+{
+    std::ostringstream dot;
+    dot << "graph G {\n";
+    dot << "    node [shape=circle, style=filled, fillcolor=lightblue, fontname=\"Arial\"];\n";
+    dot << "    edge [color=gray40];\n";
+    for (int i = 0; i < gr.vertex_count(); ++i)
+    {
+        std::string label = std::to_string(i) + ": " + vertex_to_string(gr.vertex_data(i));
+        dot << "    " << i << " [label=\"" << label << "\"];\n";
+    }
+    for (int u = 0; u < gr.vertex_count(); ++u)
+    {
+        gr.for_each_neighbor(u, [&](int v)
+                             {
+            if (u < v)
+            {
+                dot << "    " << u << " -- " << v << ";\n";
+            } });
+    }
+    dot << "}\n";
+    return dot.str();
+}
+
+double file_mb(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    return static_cast<double>(file.tellg()) / (1024.0 * 1024.0);
+}
+
+int main(int argc, char *argv[])
+{
+    int n = 1000000;
+    int m = 5000000;
+    if (argc > 1)
+    {
+        m = std::stoi(argv[1]);
+    }
+
+    std::cout << "========================================\n";
+    std::cout << "  Benchmark: Graph Input/Output\n";
+    std::cout << "========================================\n";
+
+    const std::string edge_file = "io_benchmark_edges.txt";
+    const std::string dot_file = "io_benchmark_graph.dot";
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(m);
+    {
+        std::ofstream out(edge_file);
+        out << "# FromNodeId\tToNodeId\n";
+        for (int i = 0; i < m; ++i)
+        {
+            int u = pick(rng);
+            int v = pick(rng);
+            edges.push_back({u, v});
+            out << u << '\t' << v << '\n';
+        }
+    }
+    auto generated = csr_graph<int>::from_edge_list(std::vector<int>(n, 0), edges);
+
+    std::ofstream csv("io_benchmark.csv");
+    csv << "format;edges;file_mb;time_ms;mb_per_s\n";
+
+    auto report = [&](const std::string &format, const std::string &filename, double ms)
+    {
+        double mb = file_mb(filename);
+        double throughput = ms > 0.0 ? mb / (ms / 1000.0) : 0.0;
+        csv << format << ";" << m << ";" << mb << ";" << ms << ";" << throughput << "\n";
+        std::cout << format << ": " << mb << " MB in " << ms << " ms = " << throughput << " MB/s\n";
+    };
+
+    report("dot_write_ostream", dot_file, time_ms([&]()
+                                                  {
+        std::ofstream out(dot_file);
+        out << ostream_to_dot(generated); }));
+    report("dot_write_buffered", dot_file, time_ms([&]()
+                                                   {
+        file_descriptor fd(::open(dot_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644));
+        buffered_output out(fd.get());
+        write_dot(generated, out);
+        out.flush(); }));
+
+    std::size_t arcs = 0;
+    report("edge_list", edge_file, time_ms([&]()
+                                           { arcs += read_edge_list(edge_file).arc_count(); }));
+
+    edge_list_options remapped;
+    remapped.remap_ids = true;
+    report("edge_list_remap", edge_file, time_ms([&]()
+                                                 { arcs += read_edge_list(edge_file, remapped).arc_count(); }));
+
+    report("dot", dot_file, time_ms([&]()
+                                    { arcs += read_dot(dot_file).arc_count(); }));
+
+    std::cout << "(arcs read: " << arcs << ")\n";
+    std::remove(edge_file.c_str());
+    std::remove(dot_file.c_str());
+
+    csv.close();
+    std::cout << "\nI/O benchmark results saved to io_benchmark.csv\n";
+    return 0;
+}
@@ -0,0 +1,279 @@
+#pragma once
+
+#include "euler_tour_forest.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// Fully dynamic connectivity (Holm, de Lichtenberg and Thorup). Every edge
+// has a level that only grows. Forest i spans the edges of level >= i, and
+// its trees hold at most n / 2^i vertices, so there are at most log2(n)
+// levels. Forest 0 is a spanning forest of the whole graph.
+//
+// When a tree edge at level l is deleted, the search for a replacement
+// scans levels l, l - 1, ..., 0. At each level it looks only at the smaller
+// of the two halves. Edges it checks and rejects move up a level, which
+// pays for the scan. Updates take O(log^2 n) amortized time. connected() is
+// O(log n).
+//
+// Parallel edges are counted, and an edge exists while its count is
+// positive. Self loops never affect connectivity and are ignored.
+class level_spanning_forest
+{
+private:
+    struct edge_record
+    {
+        int count = 0;
+        int level = 0;
+        bool tree = false;
+    };
+
+    struct level
+    {
+        euler_tour_forest forest;
+        // Arc nodes of the tree edges present in this forest.
+        std::unordered_map<std::uint64_t, std::pair<int, int>> arcs;
+        // Non-tree edges whose level is exactly this one, per endpoint.
+        std::unordered_map<int, std::unordered_set<int>> nontree;
+    };
+
+    int size = 0;
+    int components = 0;
+    std::vector<level> levels;
+    std::unordered_map<std::uint64_t, edge_record> edges;
+
+    static std::uint64_t key(int u, int v)
+    {
+        if (u > v)
+        {
+            std::swap(u, v);
+        }
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(u)) << 32) | static_cast<std::uint32_t>(v);
+    }
+
+    void check_vertex(int v) const
+    {
+        if (v < 0 || v >= size)
+        {
+            throw std::out_of_range("Invalid vertex ID");
+        }
+    }
+
+    level &at(int i)
+    {
+        while (static_cast<int>(levels.size()) <= i)
+        {
+            levels.emplace_back();
+            levels.back().forest.add_vertices(size);
+        }
+        return levels[i];
+    }
+
+    void link_tree_edge(int u, int v, int edge_level)
+    {
+        std::uint64_t k = key(u, v);
+        for (int i = 0; i <= edge_level; ++i)
+        {
+            level &l = at(i);
+            l.arcs[k] = l.forest.link(u, v);
+        }
+        auto [forward, backward] = levels[edge_level].arcs[k];
+        (void)backward;
+        levels[edge_level].forest.set_arc_flag(forward, euler_tour_forest::tree_edge_flag, true);
+    }
+
+    void add_nontree(int u, int v, int edge_level)
+    {
+        level &l = at(edge_level);
+        for (auto [a, b] : {std::pair<int, int>{u, v}, std::pair<int, int>{v, u}})
+        {
+            auto &incident = l.nontree[a];
+            if (incident.empty())
+            {
+                l.forest.set_vertex_flag(a, euler_tour_forest::nontree_edge_flag, true);
+            }
+            incident.insert(b);
+        }
+    }
+
+    void remove_nontree(int u, int v, int edge_level)
+    {
+        level &l = levels[edge_level];
+        for (auto [a, b] : {std::pair<int, int>{u, v}, std::pair<int, int>{v, u}})
+        {
+            auto found = l.nontree.find(a);
+            found->second.erase(b);
+            if (found->second.empty())
+            {
+                l.nontree.erase(found);
+                l.forest.set_vertex_flag(a, euler_tour_forest::nontree_edge_flag, false);
+            }
+        }
+    }
+
+    // Looks for an edge reconnecting the halves of a split tree, from the
+    // cut edge's level down to 0. Returns whether one was found.
+    bool replace(int u, int v, int from_level)
+    {
+        // Created up front so no level is reallocated while in use below.
+        at(from_level + 1);
+
+        for (int i = from_level; i >= 0; --i)
+        {
+            euler_tour_forest &forest = levels[i].forest;
+            int small = forest.tree_size(u) <= forest.tree_size(v) ? u : v;
+
+            // Tree edges of level i inside the small half move up, so the
+            // half becomes one tree of forest i + 1.
+            int arc;
+            while ((arc = forest.find_flagged(small, euler_tour_forest::tree_edge_flag)) >= 0)
+            {
+                auto [a, b] = forest.endpoints(arc);
+                forest.set_arc_flag(arc, euler_tour_forest::tree_edge_flag, false);
+                edges[key(a, b)].level = i + 1;
+                level &up = levels[i + 1];
+                std::pair<int, int> up_arcs = up.forest.link(a, b);
+                up.arcs[key(a, b)] = up_arcs;
+                up.forest.set_arc_flag(up_arcs.first, euler_tour_forest::tree_edge_flag, true);
+            }
+
+            // Each non-tree edge leaving the small half either reconnects the
+            // halves or stays inside and moves up.
+            int vertex_node;
+            while ((vertex_node = forest.find_flagged(small, euler_tour_forest::nontree_edge_flag)) >= 0)
+            {
+                int x = forest.endpoints(vertex_node).first;
+                int y = *levels[i].nontree[x].begin();
+                remove_nontree(x, y, i);
+                edge_record &record = edges[key(x, y)];
+                if (!forest.connected(y, small))
+                {
+                    record.tree = true;
+                    link_tree_edge(x, y, i);
+                    return true;
+                }
+                record.level = i + 1;
+                add_nontree(x, y, i + 1);
+            }
+        }
+        return false;
+    }
+
+public:
+    explicit level_spanning_forest(int vertex_count = 0)
+    {
+        add_vertices(vertex_count);
+    }
+
+    int vertex_count() const { return size; }
+    int component_count() const { return components; }
+
+    void add_vertices(int vertex_count)
+    {
+        if (vertex_count <= size)
+        {
+            return;
+        }
+        components += vertex_count - size;
+        size = vertex_count;
+        for (auto &l : levels)
+        {
+            l.forest.add_vertices(size);
+        }
+    }
+
+    // Returns whether the edge joined two components.
+    bool insert_edge(int u, int v)
+    {
+        check_vertex(u);
+        check_vertex(v);
+        if (u == v)
+        {
+            return false;
+        }
+        edge_record &record = edges[key(u, v)];
+        if (record.count++ > 0)
+        {
+            return false;
+        }
+        record.level = 0;
+        if (at(0).forest.connected(u, v))
+        {
+            record.tree = false;
+            add_nontree(u, v, 0);
+            return false;
+        }
+        record.tree = true;
+        link_tree_edge(u, v, 0);
+        --components;
+        return true;
+    }
+
+    // Removes one copy of the edge. Returns whether that split a component;
+    // removing an edge that is not present throws std::invalid_argument.
+    bool delete_edge(int u, int v)
+    {
+        check_vertex(u);
+        check_vertex(v);
+        if (u == v)
+        {
+            return false;
+        }
+        auto found = edges.find(key(u, v));
+        if (found == edges.end())
+        {
+            throw std::invalid_argument("Edge not present");
+        }
+        edge_record record = found->second;
+        if (--found->second.count > 0)
+        {
+            return false;
+        }
+        edges.erase(found);
+
+        if (!record.tree)
+        {
+            remove_nontree(u, v, record.level);
+            return false;
+        }
+
+        std::uint64_t k = key(u, v);
+        for (int i = 0; i <= record.level; ++i)
+        {
+            auto arcs = levels[i].arcs.find(k);
+            levels[i].forest.cut(arcs->second.first, arcs->second.second);
+            levels[i].arcs.erase(arcs);
+        }
+
+        if (replace(u, v, record.level))
+        {
+            return false;
+        }
+        ++components;
+        return true;
+    }
+
+    bool contains_edge(int u, int v) const
+    {
+        return edges.find(key(u, v)) != edges.end();
+    }
+
+    bool connected(int u, int v) const
+    {
+        check_vertex(u);
+        check_vertex(v);
+        return u == v || (!levels.empty() && levels[0].forest.connected(u, v));
+    }
+
+    int component_size(int v) const
+    {
+        check_vertex(v);
+        return levels.empty() ? 1 : levels[0].forest.tree_size(v);
+    }
+
+    std::size_t edge_count() const { return edges.size(); }
+    int level_count() const { return static_cast<int>(levels.size()); }
+};
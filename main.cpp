@@ -6,6 +6,7 @@
 #include <chrono>
 #include "undirected_graph.hpp"
 #include "dot_helper.hpp"
+#include "instrumentation.hpp"
 
 int main()
 {
@@ -126,6 +127,12 @@ int main()
                 break;
             }
 
+            if constexpr (instrumentation::enabled)
+            {
+                instrumentation::reset();
+                instrumentation::set_hardware_counting(true);
+            }
+
             auto start = std::chrono::high_resolution_clock::now();
             auto components = graph.find_connected_components();
             auto end = std::chrono::high_resolution_clock::now();
@@ -133,6 +140,10 @@ int main()
 
             std::cout << "\n Found " << components.get_length() << " component(s) in "
                       << duration_ms << " ms\n";
+            if constexpr (instrumentation::enabled)
+            {
+                std::cout << instrumentation::snapshot().to_json();
+            }
 
             for (int i = 0; i < components.get_length(); ++i)
             {
@@ -163,7 +174,7 @@ int main()
                 std::cout << "Cannot open file " << filename << "\n";
                 break;
             }
-            out << to_dot(graph);
+            write_dot(graph, out);
             out.close();
 
             std::cout << "   Graph exported to " << filename << "\n";
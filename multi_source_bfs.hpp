@@ -0,0 +1,170 @@
+#pragma once
+
+#include "parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+// Hop distances from many sources, one row per source.
+struct distance_matrix
+{
+    static constexpr int unreachable = -1;
+
+    int source_count = 0;
+    int vertex_count = 0;
+    std::vector<int> distances;
+
+    int at(int source_index, int vertex_id) const
+    {
+        return distances[static_cast<std::size_t>(source_index) * vertex_count + vertex_id];
+    }
+
+    std::span<const int> row(int source_index) const
+    {
+        return std::span<const int>(distances).subspan(static_cast<std::size_t>(source_index) * vertex_count,
+                                                       vertex_count);
+    }
+};
+
+// Per-vertex source sets of one batch, batch_words x 64 bits each.
+template <int batch_words>
+struct multi_source_workspace
+{
+    std::vector<std::uint64_t> seen;
+    std::vector<std::uint64_t> frontier;
+    std::vector<std::uint64_t> next;
+
+    void assign(int n)
+    {
+        std::size_t words = static_cast<std::size_t>(n) * batch_words;
+        seen.assign(words, 0);
+        frontier.assign(words, 0);
+        next.assign(words, 0);
+    }
+};
+
+// Runs BFS from up to 64 * batch_words sources at once (MS-BFS). Bit i of a
+// vertex's words stands for sources[i]: a level ORs each frontier vertex's
+// set into its neighbors, then keeps only the bits they had not seen. Each
+// edge is scanned once per level for the whole batch instead of once per
+// source.
+template <int batch_words, typename graph, typename visitor>
+void multi_source_batch(const graph &gr, std::span<const int> sources, int first_index,
+                        multi_source_workspace<batch_words> &workspace, visitor &visit)
+{
+    int n = gr.vertex_count();
+    workspace.assign(n);
+    std::uint64_t *seen = workspace.seen.data();
+    std::uint64_t *frontier = workspace.frontier.data();
+    std::uint64_t *next = workspace.next.data();
+
+    for (int i = 0; i < static_cast<int>(sources.size()); ++i)
+    {
+        std::size_t word = static_cast<std::size_t>(sources[i]) * batch_words + i / 64;
+        std::uint64_t bit = std::uint64_t{1} << (i % 64);
+        seen[word] |= bit;
+        frontier[word] |= bit;
+        visit(first_index + i, sources[i], 0);
+    }
+
+    bool active = !sources.empty();
+    for (int level = 1; active; ++level)
+    {
+        for (int v = 0; v < n; ++v)
+        {
+            const std::uint64_t *from = frontier + static_cast<std::size_t>(v) * batch_words;
+            std::uint64_t any = 0;
+            for (int k = 0; k < batch_words; ++k)
+            {
+                any |= from[k];
+            }
+            if (any == 0)
+            {
+                continue;
+            }
+            gr.for_each_neighbor(v, [&](int u)
+                                 {
+                std::uint64_t *to = next + static_cast<std::size_t>(u) * batch_words;
+                for (int k = 0; k < batch_words; ++k)
+                {
+                    to[k] |= from[k];
+                } });
+        }
+
+        active = false;
+        for (int u = 0; u < n; ++u)
+        {
+            std::size_t base = static_cast<std::size_t>(u) * batch_words;
+            for (int k = 0; k < batch_words; ++k)
+            {
+                std::uint64_t fresh = next[base + k] & ~seen[base + k];
+                seen[base + k] |= fresh;
+                frontier[base + k] = fresh;
+                next[base + k] = 0;
+                active |= fresh != 0;
+                while (fresh != 0)
+                {
+                    int bit = std::countr_zero(fresh);
+                    fresh &= fresh - 1;
+                    visit(first_index + k * 64 + bit, u, level);
+                }
+            }
+        }
+    }
+}
+
+// visit(source_index, vertex, distance) for every vertex reachable from
+// each source, sources[source_index] itself included at distance 0. Batches
+// of 64 * batch_words sources run in parallel, one thread per batch at a
+// time, so `visit` must be safe to call from several threads when
+// thread_count != 1; calls for one source always come from one thread.
+template <int batch_words = 1, typename graph, typename visitor>
+void multi_source_bfs(const graph &gr, std::span<const int> sources, visitor &&visit, int thread_count = 1)
+{
+    static_assert(batch_words > 0);
+    constexpr int batch_size = 64 * batch_words;
+
+    for (int s : sources)
+    {
+        if (s < 0 || s >= gr.vertex_count())
+        {
+            throw std::out_of_range("Invalid vertex ID");
+        }
+    }
+
+    int batches = static_cast<int>((sources.size() + batch_size - 1) / batch_size);
+    int workers = std::min(resolve_thread_count(thread_count), batches);
+    std::atomic<int> next_batch(0);
+
+    parallel_for(0, workers, workers, [&](int)
+                 {
+        multi_source_workspace<batch_words> workspace;
+        for (int batch = next_batch++; batch < batches; batch = next_batch++)
+        {
+            int first = batch * batch_size;
+            int count = std::min<int>(batch_size, static_cast<int>(sources.size()) - first);
+            multi_source_batch<batch_words>(gr, sources.subspan(first, count), first, workspace, visit);
+        } }, 1);
+}
+
+template <int batch_words = 1, typename graph>
+distance_matrix multi_source_distances(const graph &gr, std::span<const int> sources, int thread_count = 1)
+{
+    distance_matrix result;
+    result.source_count = static_cast<int>(sources.size());
+    result.vertex_count = gr.vertex_count();
+    result.distances.assign(static_cast<std::size_t>(result.source_count) * result.vertex_count,
+                            distance_matrix::unreachable);
+
+    int *distances = result.distances.data();
+    std::size_t n = static_cast<std::size_t>(result.vertex_count);
+    multi_source_bfs<batch_words>(gr, sources, [distances, n](int source_index, int v, int distance)
+                                  { distances[source_index * n + v] = distance; },
+                                  thread_count);
+    return result;
+}
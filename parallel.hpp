@@ -0,0 +1,130 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Non-positive thread counts mean "use every hardware thread".
+inline int resolve_thread_count(int thread_count)
+{
+    if (thread_count > 0)
+    {
+        return thread_count;
+    }
+    unsigned hardware = std::thread::hardware_concurrency();
+    return hardware == 0 ? 1 : static_cast<int>(hardware);
+}
+
+// Runs body(i) for every i in [begin, end). Workers grab chunks of `grain`
+// indices from a shared counter, which balances skewed per-index cost. The
+// first exception thrown by a worker is rethrown on the calling thread.
+template <typename F>
+void parallel_for(int begin, int end, int thread_count, F &&body, int grain = 1024)
+{
+    if (begin >= end)
+    {
+        return;
+    }
+
+    int workers = std::min(resolve_thread_count(thread_count), (end - begin + grain - 1) / grain);
+    if (workers <= 1)
+    {
+        for (int i = begin; i < end; ++i)
+        {
+            body(i);
+        }
+        return;
+    }
+
+    std::atomic<int> next(begin);
+    std::exception_ptr failure;
+    std::mutex failure_mutex;
+
+    auto worker = [&]()
+    {
+        try
+        {
+            while (true)
+            {
+                int chunk_begin = next.fetch_add(grain, std::memory_order_relaxed);
+                if (chunk_begin >= end)
+                {
+                    break;
+                }
+                int chunk_end = std::min(end, chunk_begin + grain);
+                for (int i = chunk_begin; i < chunk_end; ++i)
+                {
+                    body(i);
+                }
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(failure_mutex);
+            if (!failure)
+            {
+                failure = std::current_exception();
+            }
+            next.store(end, std::memory_order_relaxed);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (int t = 1; t < workers; ++t)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    if (failure)
+    {
+        std::rethrow_exception(failure);
+    }
+}
+
+// Sorts [first, last) with up to `thread_count` threads. Each thread sorts
+// one slice; then neighboring runs are merged in pairs, halving the number
+// of runs per round. Not stable.
+template <typename iterator, typename compare>
+void parallel_sort(iterator first, iterator last, int thread_count, compare less)
+{
+    const std::ptrdiff_t min_slice = 1 << 14;
+    std::ptrdiff_t n = last - first;
+    int workers = static_cast<int>(std::min<std::ptrdiff_t>(resolve_thread_count(thread_count), n / min_slice));
+    if (workers <= 1)
+    {
+        std::sort(first, last, less);
+        return;
+    }
+
+    std::vector<std::ptrdiff_t> bounds(workers + 1);
+    for (int i = 0; i <= workers; ++i)
+    {
+        bounds[i] = n * i / workers;
+    }
+    parallel_for(0, workers, workers, [&](int i)
+                 { std::sort(first + bounds[i], first + bounds[i + 1], less); }, 1);
+
+    for (int width = 1; width < workers; width *= 2)
+    {
+        int merges = (workers + 2 * width - 1) / (2 * width);
+        parallel_for(0, merges, workers, [&](int m)
+                     {
+            int low = m * 2 * width;
+            int middle = std::min(low + width, workers);
+            int high = std::min(low + 2 * width, workers);
+            if (middle < high)
+            {
+                std::inplace_merge(first + bounds[low], first + bounds[middle], first + bounds[high], less);
+            } }, 1);
+    }
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "lab3_2ndsem/headers/list_sequence.hpp"
+#include "lab3_2ndsem/headers/array_sequence.hpp"
+#include "parallel.hpp"
+#include "instrumentation.hpp"
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Lock-free union-find used by the parallel engine. Roots are always hooked
+// under the smaller root, so every tree is rooted at its minimum vertex.
+class min_hook_forest
+{
+private:
+    std::unique_ptr<std::atomic<int>[]> parent;
+    int size = 0;
+
+public:
+    explicit min_hook_forest(int vertex_count)
+        : parent(new std::atomic<int>[vertex_count]), size(vertex_count)
+    {
+        for (int v = 0; v < size; ++v)
+        {
+            parent[v].store(v, std::memory_order_relaxed);
+        }
+    }
+
+    int vertex_count() const { return size; }
+
+    // Path halving. Concurrent halving steps only ever replace a parent by
+    // one of its ancestors, so a failed or lost update is harmless.
+    int find(int v)
+    {
+        while (true)
+        {
+            int p = parent[v].load(std::memory_order_acquire);
+            if (p == v)
+            {
+                return v;
+            }
+            int grandparent = parent[p].load(std::memory_order_acquire);
+            if (grandparent != p)
+            {
+                parent[v].compare_exchange_weak(p, grandparent, std::memory_order_release, std::memory_order_relaxed);
+            }
+            v = grandparent;
+        }
+    }
+
+    void link(int u, int v)
+    {
+        while (true)
+        {
+            int root_u = find(u);
+            int root_v = find(v);
+            if (root_u == root_v)
+            {
+                return;
+            }
+            if (root_u < root_v)
+            {
+                std::swap(root_u, root_v);
+            }
+            int expected = root_u;
+            if (parent[root_u].compare_exchange_strong(expected, root_v, std::memory_order_acq_rel))
+            {
+                return;
+            }
+        }
+    }
+};
+
+// Component labels computed by all threads at once. The adjacency must be
+// symmetric and for_each_neighbor must be safe to call concurrently, which
+// holds for csr_graph and for undirected_graph with side-effect free
+// generators. Labels are identical to component_labels().
+template <typename graph>
+std::vector<int> parallel_component_labels(const graph &gr, int thread_count = 0)
+{
+    GRAPH_PHASE("parallel_component_labels");
+    int n = gr.vertex_count();
+    thread_count = resolve_thread_count(thread_count);
+
+    min_hook_forest forest(n);
+    auto link_neighbors = [&](int v)
+    {
+        gr.for_each_neighbor(v, [&](int u)
+                             {
+            if (u != v)
+            {
+                forest.link(v, u);
+            } });
+    };
+    parallel_for(0, n, thread_count, link_neighbors, 256);
+
+    std::vector<int> labels(n);
+    parallel_for(0, n, thread_count, [&](int v)
+                 { labels[v] = forest.find(v); });
+
+    // Roots are component minima, so numbering roots in vertex order gives
+    // the same ids as the sequential traversal. Count roots per block, then
+    // turn block counts into starting ids.
+    const int block = 1 << 16;
+    int block_count = (n + block - 1) / block;
+    std::vector<int> block_start(block_count + 1, 0);
+    auto count_roots = [&](int b)
+    {
+        int count = 0;
+        for (int v = b * block, end = std::min(n, v + block); v < end; ++v)
+        {
+            count += labels[v] == v;
+        }
+        block_start[b + 1] = count;
+    };
+    parallel_for(0, block_count, thread_count, count_roots, 1);
+
+    for (int b = 0; b < block_count; ++b)
+    {
+        block_start[b + 1] += block_start[b];
+    }
+
+    std::vector<int> root_id(n);
+    auto number_roots = [&](int b)
+    {
+        int id = block_start[b];
+        for (int v = b * block, end = std::min(n, v + block); v < end; ++v)
+        {
+            if (labels[v] == v)
+            {
+                root_id[v] = id++;
+            }
+        }
+    };
+    parallel_for(0, block_count, thread_count, number_roots, 1);
+
+    parallel_for(0, n, thread_count, [&](int v)
+                 { labels[v] = root_id[labels[v]]; });
+
+    return labels;
+}
+
+inline array_sequence<list_sequence<int>> components_from_labels(const std::vector<int> &labels)
+{
+    array_sequence<list_sequence<int>> components;
+    for (int v = 0; v < static_cast<int>(labels.size()); ++v)
+    {
+        while (labels[v] >= components.get_length())
+        {
+            components.append_element(list_sequence<int>{});
+        }
+        components[labels[v]].append_element(v);
+    }
+    return components;
+}
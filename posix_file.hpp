@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+class file_descriptor
+{
+private:
+    int fd;
+
+public:
+    explicit file_descriptor(int descriptor) : fd(descriptor) {}
+    file_descriptor(const file_descriptor &) = delete;
+    file_descriptor &operator=(const file_descriptor &) = delete;
+    ~file_descriptor()
+    {
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+    }
+
+    int get() const { return fd; }
+};
+
+class mapped_region
+{
+private:
+    void *address = MAP_FAILED;
+    std::size_t length = 0;
+
+public:
+    mapped_region(int fd, std::size_t bytes, bool writable)
+        : length(bytes)
+    {
+        int protection = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+        int mode = writable ? MAP_SHARED : MAP_PRIVATE;
+        address = ::mmap(nullptr, length, protection, mode, fd, 0);
+        if (address == MAP_FAILED)
+        {
+            throw std::runtime_error("Cannot map file");
+        }
+    }
+
+    mapped_region(const mapped_region &) = delete;
+    mapped_region &operator=(const mapped_region &) = delete;
+
+    ~mapped_region()
+    {
+        if (address != MAP_FAILED)
+        {
+            ::munmap(address, length);
+        }
+    }
+
+    unsigned char *data() const { return static_cast<unsigned char *>(address); }
+    std::size_t size() const { return length; }
+};
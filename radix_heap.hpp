@@ -0,0 +1,76 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Monotone priority queue for integer keys: every pushed key must be at
+// least the last popped one, which holds for Dijkstra with non-negative
+// weights. An item sits in the bucket of the highest bit where its key
+// differs from the last popped key and moves down at most 64 times, so
+// push is O(1) and pop amortized O(log C). There is no decrease-key; push
+// again and skip stale entries on pop.
+class radix_heap
+{
+private:
+    std::vector<std::pair<std::uint64_t, int>> buckets[65];
+    std::uint64_t last = 0;
+    std::size_t count = 0;
+
+    static int bucket_of(std::uint64_t key, std::uint64_t base)
+    {
+        return key == base ? 0 : 64 - std::countl_zero(key ^ base);
+    }
+
+public:
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+
+    void push(std::uint64_t key, int id)
+    {
+        buckets[bucket_of(key, last)].push_back({key, id});
+        ++count;
+    }
+
+    std::pair<std::uint64_t, int> pop()
+    {
+        if (buckets[0].empty())
+        {
+            int index = 1;
+            while (buckets[index].empty())
+            {
+                ++index;
+            }
+
+            std::uint64_t smallest = buckets[index].front().first;
+            for (const auto &item : buckets[index])
+            {
+                smallest = item.first < smallest ? item.first : smallest;
+            }
+            last = smallest;
+            for (const auto &item : buckets[index])
+            {
+                buckets[bucket_of(item.first, last)].push_back(item);
+            }
+            buckets[index].clear();
+        }
+
+        std::pair<std::uint64_t, int> result = buckets[0].back();
+        buckets[0].pop_back();
+        --count;
+        return result;
+    }
+
+    // Keeps bucket capacity for the next search.
+    void clear()
+    {
+        for (auto &bucket : buckets)
+        {
+            bucket.clear();
+        }
+        last = 0;
+        count = 0;
+    }
+};
@@ -0,0 +1,487 @@
+#pragma once
+
+#include "dynamic_bitset.hpp"
+#include "dary_heap.hpp"
+#include "radix_heap.hpp"
+#include "edge.hpp"
+#include "instrumentation.hpp"
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+// Graphs that hand out a vertex's neighbors as a span, so a scan can stop
+// early. Direction-optimizing BFS needs this for its bottom-up steps.
+template <typename graph>
+concept has_neighbor_span = requires(const graph &gr, int v) {
+    { gr.neighbors(v) } -> std::convertible_to<std::span<const int>>;
+    { gr.arc_count() } -> std::convertible_to<std::size_t>;
+};
+
+template <typename graph>
+struct graph_edge_type
+{
+    using type = std::monostate;
+};
+
+template <typename graph>
+    requires requires { typename graph::edge_type; }
+struct graph_edge_type<graph>
+{
+    using type = typename graph::edge_type;
+};
+
+template <typename graph>
+using graph_edge_t = typename graph_edge_type<graph>::type;
+
+// Unweighted edges have length 1.
+template <typename t_distance, typename t_edge>
+t_distance edge_length(const t_edge &weight)
+{
+    if constexpr (is_weighted_v<t_edge>)
+    {
+        if (weight < t_edge{})
+        {
+            throw std::invalid_argument("Negative edge weight");
+        }
+        return static_cast<t_distance>(weight);
+    }
+    else
+    {
+        return 1;
+    }
+}
+
+// Distance and predecessor per vertex for one search. Only the entries a
+// search touched are reset before the next one, so a point-to-point query
+// costs what it explores rather than O(vertex_count()).
+template <typename t_distance>
+struct search_labels
+{
+    static constexpr t_distance infinity = std::numeric_limits<t_distance>::max();
+
+    std::vector<t_distance> distances;
+    std::vector<int> parents;
+    std::vector<int> touched;
+
+    void reset(int n)
+    {
+        if (static_cast<int>(distances.size()) != n)
+        {
+            distances.assign(n, infinity);
+            parents.assign(n, -1);
+            touched.clear();
+            return;
+        }
+        for (int v : touched)
+        {
+            distances[v] = infinity;
+            parents[v] = -1;
+        }
+        touched.clear();
+    }
+
+    void label(int v, t_distance distance, int parent)
+    {
+        if (distances[v] == infinity)
+        {
+            touched.push_back(v);
+        }
+        distances[v] = distance;
+        parents[v] = parent;
+    }
+
+    bool reached(int v) const { return distances[v] != infinity; }
+    t_distance distance(int v) const { return distances[v]; }
+    int parent(int v) const { return parents[v]; }
+
+    // Source first; empty if `target` was not reached.
+    std::vector<int> path_to(int target) const
+    {
+        std::vector<int> path;
+        if (!reached(target))
+        {
+            return path;
+        }
+        for (int v = target; v >= 0; v = parents[v])
+        {
+            path.push_back(v);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+};
+
+struct bfs_workspace : search_labels<int>
+{
+    std::vector<int> frontier;
+    std::vector<int> next;
+    dynamic_bitset frontier_bits;
+    dynamic_bitset next_bits;
+};
+
+enum class dijkstra_heap
+{
+    // Radix heap for integral distances, d-ary heap otherwise.
+    automatic,
+    dary,
+    radix
+};
+
+template <typename t_distance>
+struct dijkstra_workspace : search_labels<t_distance>
+{
+    dary_heap<t_distance> heap;
+    radix_heap radix;
+};
+
+template <typename t_distance>
+struct bidirectional_workspace
+{
+    search_labels<t_distance> forward;
+    search_labels<t_distance> backward;
+    dary_heap<t_distance> forward_heap;
+    dary_heap<t_distance> backward_heap;
+    std::vector<int> forward_frontier;
+    std::vector<int> backward_frontier;
+    std::vector<int> next;
+    // Vertex where the two searches met on a shortest path, or -1.
+    int meeting = -1;
+
+    // Source first; empty if the last query found no path.
+    std::vector<int> path() const
+    {
+        if (meeting < 0)
+        {
+            return {};
+        }
+        std::vector<int> result = forward.path_to(meeting);
+        for (int v = backward.parent(meeting); v >= 0; v = backward.parent(v))
+        {
+            result.push_back(v);
+        }
+        return result;
+    }
+};
+
+template <typename graph>
+void check_vertex(const graph &gr, int v)
+{
+    if (v < 0 || v >= gr.vertex_count())
+    {
+        throw std::out_of_range("Invalid vertex ID");
+    }
+}
+
+// Hop distances from `source`, left in the workspace.
+//
+// On graphs with neighbor spans this is Beamer's direction-optimizing BFS:
+// top-down while the frontier is small, bottom-up (every unvisited vertex
+// looks for a parent in the frontier and stops at the first hit) once the
+// frontier's edges outnumber the unexplored ones by `alpha`, and back to
+// top-down when the frontier shrinks under n / `beta`. Other graphs cannot
+// stop a neighbor scan early, so they always run top-down.
+template <typename graph>
+void breadth_first_search(const graph &gr, int source, bfs_workspace &workspace, bool direction_optimizing = true,
+                          int alpha = 14, int beta = 24)
+{
+    GRAPH_PHASE("breadth_first_search");
+    check_vertex(gr, source);
+    int n = gr.vertex_count();
+    workspace.reset(n);
+    workspace.frontier.clear();
+    workspace.next.clear();
+
+    workspace.label(source, 0, -1);
+    workspace.frontier.push_back(source);
+
+    auto top_down_step = [&]()
+    {
+        std::size_t scout = 0;
+        workspace.next.clear();
+        for (int v : workspace.frontier)
+        {
+            int level = workspace.distances[v] + 1;
+            gr.for_each_neighbor(v, [&](int u)
+                                 {
+                if (!workspace.reached(u))
+                {
+                    workspace.label(u, level, v);
+                    workspace.next.push_back(u);
+                    if constexpr (has_neighbor_span<graph>)
+                    {
+                        scout += gr.neighbors(u).size();
+                    }
+                } });
+        }
+        workspace.frontier.swap(workspace.next);
+        return scout;
+    };
+
+    if constexpr (has_neighbor_span<graph>)
+    {
+        if (direction_optimizing)
+        {
+            std::size_t edges_to_check = gr.arc_count();
+            std::size_t scout = gr.neighbors(source).size();
+            int level = 0;
+
+            while (!workspace.frontier.empty())
+            {
+                if (scout > edges_to_check / alpha)
+                {
+                    workspace.frontier_bits.assign(n);
+                    workspace.next_bits.assign(n);
+                    for (int v : workspace.frontier)
+                    {
+                        workspace.frontier_bits.set(v);
+                    }
+                    level = workspace.distances[workspace.frontier.front()];
+
+                    std::size_t awake = workspace.frontier.size();
+                    std::size_t previous_awake;
+                    do
+                    {
+                        previous_awake = awake;
+                        awake = 0;
+                        workspace.next_bits.clear();
+                        for (int v = 0; v < n; ++v)
+                        {
+                            if (workspace.reached(v))
+                            {
+                                continue;
+                            }
+                            for (int u : gr.neighbors(v))
+                            {
+                                if (workspace.frontier_bits.test(u))
+                                {
+                                    workspace.label(v, level + 1, u);
+                                    workspace.next_bits.set(v);
+                                    ++awake;
+                                    break;
+                                }
+                            }
+                        }
+                        std::swap(workspace.frontier_bits, workspace.next_bits);
+                        ++level;
+                    } while (awake > 0 && (awake >= previous_awake || awake > static_cast<std::size_t>(n / beta)));
+
+                    workspace.frontier.clear();
+                    for (int v = 0; v < n && awake > 0; ++v)
+                    {
+                        if (workspace.frontier_bits.test(v))
+                        {
+                            workspace.frontier.push_back(v);
+                        }
+                    }
+                    scout = 1;
+                }
+                else
+                {
+                    edges_to_check -= std::min(edges_to_check, scout);
+                    scout = top_down_step();
+                }
+            }
+            return;
+        }
+    }
+
+    while (!workspace.frontier.empty())
+    {
+        top_down_step();
+    }
+}
+
+// Single-source shortest paths for non-negative weights; unweighted graphs
+// count hops. With `target` set the search stops once it is settled.
+template <typename graph, typename t_distance>
+void dijkstra(const graph &gr, int source, dijkstra_workspace<t_distance> &workspace, int target = -1,
+              dijkstra_heap heap = dijkstra_heap::automatic)
+{
+    using t_edge = graph_edge_t<graph>;
+    check_vertex(gr, source);
+    if (target != -1)
+    {
+        check_vertex(gr, target);
+    }
+    int n = gr.vertex_count();
+    workspace.reset(n);
+    workspace.label(source, 0, -1);
+
+    bool use_radix = heap == dijkstra_heap::radix ||
+                     (heap == dijkstra_heap::automatic && std::is_integral_v<t_distance>);
+
+    if constexpr (std::is_integral_v<t_distance>)
+    {
+        if (use_radix)
+        {
+            auto &queue = workspace.radix;
+            queue.clear();
+            queue.push(0, source);
+            while (!queue.empty())
+            {
+                auto [key, v] = queue.pop();
+                t_distance distance = static_cast<t_distance>(key);
+                if (distance != workspace.distances[v])
+                {
+                    continue;
+                }
+                if (v == target)
+                {
+                    break;
+                }
+                gr.for_each_edge(v, [&](int u, const t_edge &weight)
+                                 {
+                    t_distance candidate = distance + edge_length<t_distance>(weight);
+                    if (candidate < workspace.distances[u])
+                    {
+                        workspace.label(u, candidate, v);
+                        queue.push(static_cast<std::uint64_t>(candidate), u);
+                    } });
+            }
+            queue.clear();
+            return;
+        }
+    }
+    else if (use_radix)
+    {
+        throw std::invalid_argument("Radix heap needs integral distances");
+    }
+
+    auto &queue = workspace.heap;
+    queue.clear();
+    queue.reserve_ids(n);
+    queue.push_or_decrease(source, 0);
+    while (!queue.empty())
+    {
+        auto [distance, v] = queue.pop();
+        if (v == target)
+        {
+            break;
+        }
+        gr.for_each_edge(v, [&](int u, const t_edge &weight)
+                         {
+            t_distance candidate = distance + edge_length<t_distance>(weight);
+            if (candidate < workspace.distances[u])
+            {
+                workspace.label(u, candidate, v);
+                queue.push_or_decrease(u, candidate);
+            } });
+    }
+    queue.clear();
+}
+
+// Point-to-point distance from two searches that meet in the middle:
+// level-synchronous BFS from both ends (growing the smaller frontier) on
+// unweighted graphs, bidirectional Dijkstra otherwise. Returns
+// search_labels<t_distance>::infinity when `target` is unreachable; the
+// path is available from workspace.path().
+template <typename graph, typename t_distance>
+t_distance bidirectional_search(const graph &gr, int source, int target, bidirectional_workspace<t_distance> &workspace)
+{
+    using t_edge = graph_edge_t<graph>;
+    constexpr t_distance infinity = search_labels<t_distance>::infinity;
+    check_vertex(gr, source);
+    check_vertex(gr, target);
+    int n = gr.vertex_count();
+
+    auto &forward = workspace.forward;
+    auto &backward = workspace.backward;
+    forward.reset(n);
+    backward.reset(n);
+    forward.label(source, 0, -1);
+    backward.label(target, 0, -1);
+    workspace.meeting = source == target ? source : -1;
+    t_distance best = source == target ? 0 : infinity;
+    if (source == target)
+    {
+        return best;
+    }
+
+    if constexpr (!is_weighted_v<t_edge>)
+    {
+        auto &forward_frontier = workspace.forward_frontier;
+        auto &backward_frontier = workspace.backward_frontier;
+        forward_frontier.assign(1, source);
+        backward_frontier.assign(1, target);
+
+        while (!forward_frontier.empty() && !backward_frontier.empty() && best == infinity)
+        {
+            bool grow_forward = forward_frontier.size() <= backward_frontier.size();
+            auto &frontier = grow_forward ? forward_frontier : backward_frontier;
+            auto &labels = grow_forward ? forward : backward;
+            auto &other = grow_forward ? backward : forward;
+
+            workspace.next.clear();
+            for (int v : frontier)
+            {
+                t_distance level = labels.distances[v] + 1;
+                gr.for_each_neighbor(v, [&](int u)
+                                     {
+                    if (labels.reached(u))
+                    {
+                        return;
+                    }
+                    labels.label(u, level, v);
+                    workspace.next.push_back(u);
+                    if (other.reached(u) && level + other.distances[u] < best)
+                    {
+                        best = level + other.distances[u];
+                        workspace.meeting = u;
+                    } });
+            }
+            frontier.swap(workspace.next);
+        }
+        return best;
+    }
+    else
+    {
+        auto &forward_heap = workspace.forward_heap;
+        auto &backward_heap = workspace.backward_heap;
+        forward_heap.clear();
+        backward_heap.clear();
+        forward_heap.reserve_ids(n);
+        backward_heap.reserve_ids(n);
+        forward_heap.push_or_decrease(source, 0);
+        backward_heap.push_or_decrease(target, 0);
+
+        while (!forward_heap.empty() && !backward_heap.empty())
+        {
+            t_distance forward_top = forward_heap.top().first;
+            t_distance backward_top = backward_heap.top().first;
+            if (best != infinity && forward_top + backward_top >= best)
+            {
+                break;
+            }
+
+            bool grow_forward = forward_top <= backward_top;
+            auto &queue = grow_forward ? forward_heap : backward_heap;
+            auto &labels = grow_forward ? forward : backward;
+            auto &other = grow_forward ? backward : forward;
+
+            auto [distance, v] = queue.pop();
+            gr.for_each_edge(v, [&](int u, const t_edge &weight)
+                             {
+                t_distance candidate = distance + edge_length<t_distance>(weight);
+                if (candidate < labels.distances[u])
+                {
+                    labels.label(u, candidate, v);
+                    queue.push_or_decrease(u, candidate);
+                }
+                if (other.reached(u) && labels.distances[u] + other.distances[u] < best)
+                {
+                    best = labels.distances[u] + other.distances[u];
+                    workspace.meeting = u;
+                } });
+        }
+        forward_heap.clear();
+        backward_heap.clear();
+        return best;
+    }
+}
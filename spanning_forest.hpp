@@ -0,0 +1,302 @@
+#pragma once
+
+#include "disjoint_set.hpp"
+#include "instrumentation.hpp"
+#include "parallel.hpp"
+#include "parallel_connected_components.hpp"
+#include "shortest_paths.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Minimum spanning forests: one minimum spanning tree per connected
+// component. Unweighted graphs count every edge as 1, which gives a plain
+// spanning forest.
+//
+// The adjacency must be symmetric. Each edge is taken from its smaller
+// endpoint; self loops are ignored and parallel edges compete like any
+// others. Equal weights are ordered by endpoints, so Kruskal and Boruvka
+// return the same forest.
+
+template <typename graph>
+using forest_weight_t = std::conditional_t<is_weighted_v<graph_edge_t<graph>>, graph_edge_t<graph>, int>;
+
+template <typename t_weight>
+struct forest_edge
+{
+    // u < v
+    int u;
+    int v;
+    t_weight weight;
+};
+
+template <typename t_weight>
+bool lighter_edge(const forest_edge<t_weight> &a, const forest_edge<t_weight> &b)
+{
+    if (a.weight < b.weight)
+    {
+        return true;
+    }
+    if (b.weight < a.weight)
+    {
+        return false;
+    }
+    return a.u < b.u || (a.u == b.u && a.v < b.v);
+}
+
+template <typename t_weight>
+struct spanning_forest
+{
+    // Lightest first, in lighter_edge order.
+    std::vector<forest_edge<t_weight>> edges;
+    // Numbered as in component_labels().
+    std::vector<int> component_of;
+    // Sum of forest edge weights per component; isolated vertices get 0.
+    std::vector<t_weight> component_weight;
+    t_weight total_weight{};
+
+    int component_count() const { return static_cast<int>(component_weight.size()); }
+};
+
+enum class spanning_forest_method
+{
+    kruskal,
+    boruvka
+};
+
+// Every edge once, from its smaller endpoint. Counts per vertex first, so
+// both passes can run in parallel; generators are called twice per vertex.
+template <typename graph>
+std::vector<forest_edge<forest_weight_t<graph>>> collect_forest_edges(const graph &gr, int threads = 1)
+{
+    using t_edge = graph_edge_t<graph>;
+    using t_weight = forest_weight_t<graph>;
+    int n = gr.vertex_count();
+
+    auto for_each_upper = [&](int v, auto &&take)
+    {
+        gr.for_each_edge(v, [&](int u, const t_edge &weight)
+                         {
+            if (v < u)
+            {
+                if constexpr (is_weighted_v<t_edge>)
+                {
+                    take(u, weight);
+                }
+                else
+                {
+                    (void)weight;
+                    take(u, t_weight(1));
+                }
+            } });
+    };
+
+    std::vector<std::size_t> offsets(n + 1, 0);
+    parallel_for(0, n, threads, [&](int v)
+                 {
+        std::size_t count = 0;
+        for_each_upper(v, [&](int, const t_weight &)
+                       { ++count; });
+        offsets[v + 1] = count; }, 256);
+    for (int v = 0; v < n; ++v)
+    {
+        offsets[v + 1] += offsets[v];
+    }
+
+    std::vector<forest_edge<t_weight>> edges(offsets[n]);
+    parallel_for(0, n, threads, [&](int v)
+                 {
+        std::size_t i = offsets[v];
+        for_each_upper(v, [&](int u, const t_weight &weight)
+                       { edges[i++] = {v, u, weight}; }); }, 256);
+    return edges;
+}
+
+// Component numbering and per-component weights of a finished forest.
+template <typename t_weight>
+spanning_forest<t_weight> summarize_forest(int n, std::vector<forest_edge<t_weight>> edges)
+{
+    spanning_forest<t_weight> result;
+    min_hook_forest trees(n);
+    for (const auto &e : edges)
+    {
+        trees.link(e.u, e.v);
+    }
+
+    // Roots are component minima, so they come first in vertex order.
+    result.component_of.resize(n);
+    int count = 0;
+    for (int v = 0; v < n; ++v)
+    {
+        int root = trees.find(v);
+        result.component_of[v] = root == v ? count++ : result.component_of[root];
+    }
+    result.component_weight.assign(count, t_weight{});
+    for (const auto &e : edges)
+    {
+        result.component_weight[result.component_of[e.u]] += e.weight;
+        result.total_weight += e.weight;
+    }
+    result.edges = std::move(edges);
+    return result;
+}
+
+// Sorts all edges (in parallel with threads != 1) and keeps each one that
+// joins two trees of a disjoint_set.
+template <typename graph>
+spanning_forest<forest_weight_t<graph>> kruskal_spanning_forest(const graph &gr, int threads = 1)
+{
+    using t_weight = forest_weight_t<graph>;
+    GRAPH_PHASE("kruskal_spanning_forest");
+    int n = gr.vertex_count();
+
+    std::vector<forest_edge<t_weight>> candidates = collect_forest_edges(gr, threads);
+    parallel_sort(candidates.begin(), candidates.end(), threads, lighter_edge<t_weight>);
+
+    disjoint_set trees(n);
+    std::vector<forest_edge<t_weight>> chosen;
+    chosen.reserve(n > 0 ? n - 1 : 0);
+    for (const auto &e : candidates)
+    {
+        if (trees.unite(e.u, e.v))
+        {
+            chosen.push_back(e);
+            if (static_cast<int>(chosen.size()) == n - 1)
+            {
+                break;
+            }
+        }
+    }
+    return summarize_forest(n, std::move(chosen));
+}
+
+// Each round every component picks its lightest outgoing edge, all picked
+// edges join the forest, and the merged components are relabeled. Picking
+// is a CAS-min on a per-component slot, so threads never lock. With ties
+// broken by endpoints and then by candidate index, the picks contain no
+// cycle other than two components picking the same edge, which is added
+// once. Edges inside one component are dropped after every round, and the
+// number of components at least halves per round.
+template <typename graph>
+spanning_forest<forest_weight_t<graph>> boruvka_spanning_forest(const graph &gr, int threads = 0)
+{
+    using t_weight = forest_weight_t<graph>;
+    GRAPH_PHASE("boruvka_spanning_forest");
+    threads = resolve_thread_count(threads);
+    int n = gr.vertex_count();
+
+    std::vector<forest_edge<t_weight>> edges = collect_forest_edges(gr, threads);
+    auto precedes = [&](int a, int b)
+    {
+        if (lighter_edge(edges[a], edges[b]))
+        {
+            return true;
+        }
+        if (lighter_edge(edges[b], edges[a]))
+        {
+            return false;
+        }
+        return a < b;
+    };
+
+    std::vector<int> component(n);
+    std::iota(component.begin(), component.end(), 0);
+    std::unique_ptr<std::atomic<int>[]> best(new std::atomic<int>[n]);
+    min_hook_forest trees(n);
+    std::vector<forest_edge<t_weight>> chosen(n > 0 ? n - 1 : 0);
+    std::atomic<int> chosen_count(0);
+
+    std::vector<int> alive(edges.size());
+    std::iota(alive.begin(), alive.end(), 0);
+    std::vector<int> next_alive;
+    while (!alive.empty())
+    {
+        parallel_for(0, n, threads, [&](int c)
+                     { best[c].store(-1, std::memory_order_relaxed); });
+
+        parallel_for(0, static_cast<int>(alive.size()), threads, [&](int i)
+                     {
+            int e = alive[i];
+            int ends[2] = {component[edges[e].u], component[edges[e].v]};
+            for (int c : ends)
+            {
+                int current = best[c].load(std::memory_order_relaxed);
+                while ((current < 0 || precedes(e, current)) &&
+                       !best[c].compare_exchange_weak(current, e, std::memory_order_relaxed))
+                {
+                }
+            } });
+
+        parallel_for(0, n, threads, [&](int c)
+                     {
+            int e = best[c].load(std::memory_order_relaxed);
+            if (e < 0)
+            {
+                return;
+            }
+            int other = component[edges[e].u] == c ? component[edges[e].v] : component[edges[e].u];
+            if (other < c && best[other].load(std::memory_order_relaxed) == e)
+            {
+                return;
+            }
+            chosen[chosen_count.fetch_add(1, std::memory_order_relaxed)] = edges[e];
+            trees.link(c, other); });
+
+        parallel_for(0, n, threads, [&](int v)
+                     { component[v] = trees.find(v); });
+
+        // Keep edges that still join two components, in chunks so the
+        // survivors stay in order.
+        int m = static_cast<int>(alive.size());
+        int chunks = std::max(1, std::min(threads * 4, m / 4096));
+        std::vector<int> kept(chunks + 1, 0);
+        auto crosses = [&](int e)
+        {
+            return component[edges[e].u] != component[edges[e].v];
+        };
+        parallel_for(0, chunks, threads, [&](int k)
+                     {
+            int count = 0;
+            for (int i = static_cast<int>(1LL * m * k / chunks); i < static_cast<int>(1LL * m * (k + 1) / chunks); ++i)
+            {
+                count += crosses(alive[i]);
+            }
+            kept[k + 1] = count; }, 1);
+        for (int k = 0; k < chunks; ++k)
+        {
+            kept[k + 1] += kept[k];
+        }
+        next_alive.resize(kept[chunks]);
+        parallel_for(0, chunks, threads, [&](int k)
+                     {
+            int out = kept[k];
+            for (int i = static_cast<int>(1LL * m * k / chunks); i < static_cast<int>(1LL * m * (k + 1) / chunks); ++i)
+            {
+                if (crosses(alive[i]))
+                {
+                    next_alive[out++] = alive[i];
+                }
+            } }, 1);
+        alive.swap(next_alive);
+    }
+
+    chosen.resize(chosen_count.load());
+    parallel_sort(chosen.begin(), chosen.end(), threads, lighter_edge<t_weight>);
+    return summarize_forest(n, std::move(chosen));
+}
+
+template <typename graph>
+spanning_forest<forest_weight_t<graph>> minimum_spanning_forest(
+    const graph &gr, spanning_forest_method method = spanning_forest_method::boruvka, int threads = 0)
+{
+    if (method == spanning_forest_method::kruskal)
+    {
+        return kruskal_spanning_forest(gr, threads);
+    }
+    return boruvka_spanning_forest(gr, threads);
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include "undirected_graph.hpp"
+#include "dot_helper.hpp"
+
+namespace
+{
+    // Path 0 - 1 - ... - (n - 1) whose generators count their invocations.
+    void build_counted_path(undirected_graph<int> &graph, int n, std::shared_ptr<int> calls)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            graph.add_vertex(i);
+        }
+        for (int i = 0; i < n; ++i)
+        {
+            graph.set_edge_generator(i, [i, n, calls]()
+                                     {
+                ++*calls;
+                list_sequence<int> neighbors;
+                if (i > 0)
+                {
+                    neighbors.append_element(i - 1);
+                }
+                if (i + 1 < n)
+                {
+                    neighbors.append_element(i + 1);
+                }
+                return neighbors; });
+        }
+    }
+}
+
+TEST(test_adjacency_cache, disabled_by_default)
+{
+    auto calls = std::make_shared<int>(0);
+    undirected_graph<int> graph;
+    build_counted_path(graph, 10, calls);
+
+    graph.find_connected_components();
+    graph.find_connected_components();
+
+    EXPECT_EQ(*calls, 20);
+    EXPECT_EQ(graph.get_cache_stats().hits, 0u);
+    EXPECT_EQ(graph.get_cache_stats().misses, 0u);
+}
+
+TEST(test_adjacency_cache, materialize_runs_each_generator_once)
+{
+    auto calls = std::make_shared<int>(0);
+    undirected_graph<int> graph;
+    build_counted_path(graph, 10, calls);
+    graph.set_cache_config({cache_policy::materialize, 0});
+
+    auto first = graph.find_connected_components();
+    std::string dot = to_dot(graph);
+    auto second = graph.find_connected_components();
+
+    EXPECT_EQ(*calls, 10);
+    EXPECT_EQ(second.get_length(), 1);
+    EXPECT_EQ(second[0].get_length(), 10);
+
+    auto stats = graph.get_cache_stats();
+    EXPECT_EQ(stats.misses, 10u);
+    EXPECT_EQ(stats.hits, 20u);
+    EXPECT_EQ(stats.entries, 10u);
+    EXPECT_EQ(stats.evictions, 0u);
+    EXPECT_GT(stats.bytes, 0u);
+
+    auto neighbors = graph.neighbors(5);
+    EXPECT_EQ(neighbors.get_length(), 2);
+    EXPECT_EQ(neighbors.get(0), 4);
+    EXPECT_EQ(*calls, 10);
+}
+
+TEST(test_adjacency_cache, set_edge_generator_invalidates_entry)
+{
+    auto calls = std::make_shared<int>(0);
+    undirected_graph<int> graph;
+    build_counted_path(graph, 3, calls);
+    graph.set_cache_config({cache_policy::materialize, 0});
+
+    EXPECT_EQ(graph.neighbors(0).get_length(), 1);
+
+    graph.set_edge_generator(0, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(1);
+        neighbors.append_element(2);
+        return neighbors; });
+
+    EXPECT_EQ(graph.neighbors(0).get_length(), 2);
+    EXPECT_EQ(graph.get_cache_stats().invalidations, 1u);
+    EXPECT_EQ(graph.get_cache_stats().misses, 2u);
+}
+
+TEST(test_adjacency_cache, lru_respects_byte_budget)
+{
+    auto calls = std::make_shared<int>(0);
+    undirected_graph<int> graph;
+    build_counted_path(graph, 100, calls);
+
+    graph.set_cache_config({cache_policy::materialize, 0});
+    graph.neighbors(1);
+    std::size_t entry_bytes = graph.get_cache_stats().bytes;
+
+    graph.set_cache_config({cache_policy::lru, entry_bytes * 4});
+    graph.find_connected_components();
+
+    auto stats = graph.get_cache_stats();
+    EXPECT_LE(stats.bytes, entry_bytes * 4);
+    EXPECT_LE(stats.entries, 4u);
+    EXPECT_GT(stats.evictions, 0u);
+    EXPECT_EQ(stats.misses, 100u);
+
+    graph.clear_cache();
+    for (int v = 1; v <= 6; ++v)
+    {
+        graph.neighbors(v);
+    }
+    int before = *calls;
+    graph.neighbors(6);
+    EXPECT_EQ(*calls, before);
+    graph.neighbors(1);
+    EXPECT_EQ(*calls, before + 1);
+
+    graph.clear_cache();
+    EXPECT_EQ(graph.get_cache_stats().entries, 0u);
+    EXPECT_EQ(graph.get_cache_stats().bytes, 0u);
+}
+
+TEST(test_adjacency_cache, allocates_from_graph_memory_resource)
+{
+    struct counting_resource : std::pmr::memory_resource
+    {
+        std::size_t allocations = 0;
+        std::size_t outstanding = 0;
+
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            ++allocations;
+            outstanding += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override
+        {
+            outstanding -= bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+        {
+            return this == &other;
+        }
+    } resource;
+
+    {
+        undirected_graph<int> graph(&resource);
+        EXPECT_EQ(graph.memory_resource(), &resource);
+        build_counted_path(graph, 50, std::make_shared<int>(0));
+        graph.set_cache_config({cache_policy::materialize});
+
+        std::size_t before = resource.allocations;
+        EXPECT_EQ(graph.find_component_labels(), std::vector<int>(50, 0));
+        EXPECT_GT(resource.allocations, before + 50);
+        EXPECT_EQ(graph.get_cache_stats().entries, 50u);
+
+        undirected_graph<int> copy = graph;
+        EXPECT_EQ(copy.memory_resource(), &resource);
+    }
+    EXPECT_EQ(resource.outstanding, 0u);
+}
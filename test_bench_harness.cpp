@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include "bench_harness.hpp"
+
+TEST(test_bench_harness, percentiles_interpolate_between_ranks)
+{
+    std::vector<double> sorted = {1, 2, 3, 4, 5};
+    EXPECT_DOUBLE_EQ(percentile(sorted, 0.0), 1.0);
+    EXPECT_DOUBLE_EQ(percentile(sorted, 0.5), 3.0);
+    EXPECT_DOUBLE_EQ(percentile(sorted, 0.9), 4.6);
+    EXPECT_DOUBLE_EQ(percentile(sorted, 1.0), 5.0);
+    EXPECT_DOUBLE_EQ(percentile({}, 0.5), 0.0);
+
+    auto stats = summarize({5, 1, 4, 2, 3});
+    EXPECT_EQ(stats.samples, 5);
+    EXPECT_DOUBLE_EQ(stats.min, 1.0);
+    EXPECT_DOUBLE_EQ(stats.max, 5.0);
+    EXPECT_DOUBLE_EQ(stats.mean, 3.0);
+    EXPECT_DOUBLE_EQ(stats.p50, 3.0);
+    EXPECT_NEAR(stats.stddev, 1.5811388, 1e-6);
+}
+
+TEST(test_bench_harness, measure_runs_warmup_and_iterations)
+{
+    int calls = 0;
+    auto stats = measure(bench_config{2, 5}, [&]()
+                         { ++calls; });
+    EXPECT_EQ(calls, 7);
+    EXPECT_EQ(stats.samples, 5);
+    EXPECT_LE(stats.min, stats.p50);
+    EXPECT_LE(stats.p99, stats.max);
+}
+
+TEST(test_bench_harness, report_is_escaped_json)
+{
+    bench_report report;
+    EXPECT_EQ(report.to_json(), "{\n  \"context\": {},\n  \"unit\": \"ms\",\n  \"benchmarks\": []\n}\n");
+
+    report.set_context("compiler", "gcc \"x\"\n");
+    report.set_context("compiler", "gcc \"13\"");
+    report.add({"bfs", "query", "grid\\1", 4, 3, summarize({1.5})});
+    std::ostringstream stream;
+    report.write_json(stream);
+    std::string json = stream.str();
+
+    EXPECT_NE(json.find("\"compiler\": \"gcc \\\"13\\\"\""), std::string::npos);
+    EXPECT_EQ(json.find("\\n\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\": \"bfs\", \"phase\": \"query\", \"graph\": \"grid\\\\1\""), std::string::npos);
+    EXPECT_NE(json.find("\"vertices\": 4, \"edges\": 3, \"samples\": 1"), std::string::npos);
+    EXPECT_NE(json.find("\"p99\": 1.5"), std::string::npos);
+    EXPECT_EQ(report.results().size(), 1u);
+
+    std::string escaped;
+    append_json_string(escaped, std::string("a\tb\x01", 4));
+    EXPECT_EQ(escaped, "\"a\\tb\\u0001\"");
+}
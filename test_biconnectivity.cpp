@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include "biconnectivity.hpp"
+#include "csr_graph.hpp"
+#include "graph_builder.hpp"
+
+namespace
+{
+    // Components of the graph with one edge or one vertex taken out.
+    int component_count(int n, const std::vector<std::pair<int, int>> &edges, int skip_edge, int skip_vertex)
+    {
+        std::vector<std::pair<int, int>> kept;
+        for (int i = 0; i < static_cast<int>(edges.size()); ++i)
+        {
+            auto [u, v] = edges[i];
+            if (i != skip_edge && u != skip_vertex && v != skip_vertex)
+            {
+                kept.push_back(edges[i]);
+            }
+        }
+        auto csr = csr_graph<int>::from_edge_list(std::vector<int>(n, 0), kept);
+        int count = csr.find_connected_components().get_length();
+        return skip_vertex >= 0 ? count - 1 : count;
+    }
+}
+
+TEST(test_biconnectivity, two_triangles_joined_by_a_bridge)
+{
+    // 0-1-2 triangle, bridge 2-3, 3-4-5 triangle, pendant 5-6, isolated 7.
+    auto csr = csr_graph<int>::from_edge_list(std::vector<int>(8, 0),
+                                              {{0, 1}, {1, 2}, {2, 0}, {2, 3}, {3, 4}, {4, 5}, {5, 3}, {5, 6}});
+    auto result = biconnectivity(csr);
+
+    EXPECT_EQ(result.bridges, (std::vector<std::pair<int, int>>{{5, 6}, {2, 3}}));
+    EXPECT_EQ(result.articulation_points, (std::vector<int>{2, 3, 5}));
+
+    std::set<std::set<int>> blocks;
+    for (int b = 0; b < result.block_count(); ++b)
+    {
+        blocks.insert(std::set<int>(result.block(b).begin(), result.block(b).end()));
+    }
+    EXPECT_EQ(blocks, (std::set<std::set<int>>{{0, 1, 2}, {2, 3}, {3, 4, 5}, {5, 6}}));
+}
+
+TEST(test_biconnectivity, parallel_edges_and_self_loops)
+{
+    auto csr = csr_graph<int>::from_edge_list(std::vector<int>(3, 0), {{0, 1}, {0, 1}, {1, 2}, {2, 2}});
+    auto result = biconnectivity(csr);
+
+    EXPECT_EQ(result.bridges, (std::vector<std::pair<int, int>>{{1, 2}}));
+    EXPECT_EQ(result.articulation_points, (std::vector<int>{1}));
+    EXPECT_EQ(result.block_count(), 2);
+}
+
+TEST(test_biconnectivity, matches_brute_force_on_random_graphs)
+{
+    std::mt19937 rng(31);
+    for (int trial = 0; trial < 30; ++trial)
+    {
+        int n = 12 + trial % 7;
+        std::uniform_int_distribution<int> pick(0, n - 1);
+        std::vector<std::pair<int, int>> edges;
+        for (int i = 0; i < n + trial % 9; ++i)
+        {
+            edges.push_back({pick(rng), pick(rng)});
+        }
+        auto graph = build_undirected_graph(std::vector<int>(n, 0), edges, {true, false, false, 1});
+        auto result = biconnectivity(graph);
+        int base = component_count(n, edges, -1, -1);
+
+        std::set<std::pair<int, int>> expected_bridges;
+        for (int i = 0; i < static_cast<int>(edges.size()); ++i)
+        {
+            if (component_count(n, edges, i, -1) > base)
+            {
+                auto [u, v] = edges[i];
+                expected_bridges.insert({std::min(u, v), std::max(u, v)});
+            }
+        }
+        std::set<std::pair<int, int>> bridges(result.bridges.begin(), result.bridges.end());
+        EXPECT_EQ(bridges, expected_bridges);
+
+        std::vector<int> expected_points;
+        for (int v = 0; v < n; ++v)
+        {
+            if (component_count(n, edges, -1, v) > base)
+            {
+                expected_points.push_back(v);
+            }
+        }
+        EXPECT_EQ(result.articulation_points, expected_points);
+    }
+}
+
+TEST(test_biconnectivity, long_path_does_not_overflow_stack)
+{
+    const int n = 1000000;
+    std::vector<std::pair<int, int>> edges;
+    for (int v = 0; v + 1 < n; ++v)
+    {
+        edges.push_back({v, v + 1});
+    }
+    auto csr = csr_graph<int>::from_edge_list(std::vector<int>(n, 0), edges);
+
+    biconnectivity_workspace workspace;
+    auto result = biconnectivity(csr, workspace);
+    EXPECT_EQ(result.bridges.size(), static_cast<std::size_t>(n - 1));
+    EXPECT_EQ(result.articulation_points.size(), static_cast<std::size_t>(n - 2));
+    EXPECT_EQ(result.block_count(), n - 1);
+}
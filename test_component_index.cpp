@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include "component_index.hpp"
+#include "csr_graph.hpp"
+#include "graph_builder.hpp"
+#include "undirected_graph.hpp"
+
+TEST(test_component_index, tables_match_component_traversal)
+{
+    // {0, 2, 5}, {1, 3}, {4}, {6}
+    auto csr = csr_graph<int>::from_edge_list(std::vector<int>(7, 0), {{0, 2}, {2, 5}, {1, 3}});
+    component_index index = component_index::build(csr);
+
+    EXPECT_EQ(index.vertex_count(), 7);
+    EXPECT_EQ(index.component_count(), 4);
+    EXPECT_EQ(std::vector<int>(index.label_array().begin(), index.label_array().end()), component_labels(csr));
+    EXPECT_EQ(std::vector<int>(index.size_array().begin(), index.size_array().end()), (std::vector<int>{3, 2, 1, 1}));
+    EXPECT_EQ(std::vector<int>(index.offset_array().begin(), index.offset_array().end()),
+              (std::vector<int>{0, 3, 5, 6, 7}));
+
+    auto members = index.members(0);
+    EXPECT_EQ(std::vector<int>(members.begin(), members.end()), (std::vector<int>{0, 2, 5}));
+    EXPECT_EQ(index.component_size(5), 3);
+    EXPECT_EQ(index.component_size(6), 1);
+    EXPECT_TRUE(index.connected(0, 5));
+    EXPECT_FALSE(index.connected(0, 1));
+    EXPECT_EQ(index.component_of(3), index.component_of(1));
+
+    EXPECT_THROW(index.connected(0, 7), std::out_of_range);
+    EXPECT_THROW(index.component_size(-1), std::out_of_range);
+    EXPECT_THROW(index.members(4), std::out_of_range);
+    EXPECT_THROW(component_index(std::vector<int>{0, 2, 2}), std::invalid_argument);
+
+    component_index empty;
+    EXPECT_EQ(empty.vertex_count(), 0);
+    EXPECT_EQ(empty.component_count(), 0);
+}
+
+TEST(test_component_index, batches_match_single_queries)
+{
+    std::mt19937 rng(41);
+    const int n = 3000;
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i < n / 2; ++i)
+    {
+        edges.push_back({pick(rng), pick(rng)});
+    }
+    auto csr = build_csr_graph(std::vector<int>(n, 0), edges);
+    component_index serial = component_index::build(csr);
+    component_index parallel = component_index::build(csr, 4);
+    EXPECT_EQ(std::vector<int>(serial.label_array().begin(), serial.label_array().end()),
+              std::vector<int>(parallel.label_array().begin(), parallel.label_array().end()));
+
+    // Odd lengths exercise the scalar tail after the vector loop.
+    std::vector<std::pair<int, int>> queries;
+    std::vector<int> vertices;
+    for (int i = 0; i < 1001; ++i)
+    {
+        queries.push_back({pick(rng), pick(rng)});
+        vertices.push_back(pick(rng));
+    }
+    queries.push_back({7, 7});
+
+    auto answers = serial.connected_batch(queries);
+    auto sizes = serial.component_size_batch(vertices);
+    ASSERT_EQ(answers.size(), queries.size());
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        EXPECT_EQ(answers[i] != 0, serial.connected(queries[i].first, queries[i].second));
+    }
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+    {
+        EXPECT_EQ(sizes[i], serial.component_size(vertices[i]));
+    }
+
+    queries[5].second = n;
+    EXPECT_THROW(serial.connected_batch(queries), std::out_of_range);
+    vertices[1000] = -3;
+    EXPECT_THROW(serial.component_size_batch(vertices), std::out_of_range);
+    std::vector<char> short_answers(3);
+    EXPECT_THROW(serial.connected_batch(queries, short_answers), std::invalid_argument);
+}
+
+TEST(test_component_index, tracked_index_rebuilds_after_graph_changes)
+{
+    undirected_graph<int> graph;
+    for (int v = 0; v < 4; ++v)
+    {
+        graph.add_vertex(v);
+    }
+    auto link = [&](int v, std::vector<int> neighbors)
+    {
+        graph.set_edge_generator(v, [neighbors]()
+                                 {
+            list_sequence<int> result;
+            for (int u : neighbors)
+            {
+                result.append_element(u);
+            }
+            return result; });
+    };
+    link(0, {1});
+    link(1, {0});
+
+    tracked_component_index<int> tracked(graph);
+    component_index before = tracked.snapshot();
+    EXPECT_TRUE(before.connected(0, 1));
+    EXPECT_FALSE(before.connected(1, 2));
+    EXPECT_EQ(tracked.snapshot().component_count(), 3);
+    EXPECT_EQ(tracked.rebuild_count(), 1u);
+    EXPECT_FALSE(tracked.is_stale());
+
+    link(1, {0, 2});
+    link(2, {1});
+    EXPECT_TRUE(tracked.is_stale());
+    component_index after = tracked.snapshot();
+    EXPECT_TRUE(after.connected(0, 2));
+    EXPECT_EQ(after.component_size(0), 3);
+    EXPECT_EQ(tracked.rebuild_count(), 2u);
+
+    // Old snapshots keep their tables.
+    EXPECT_FALSE(before.connected(0, 2));
+
+    graph.add_vertex(4);
+    EXPECT_EQ(tracked.snapshot().vertex_count(), 5);
+    EXPECT_EQ(tracked.rebuild_count(), 3u);
+}
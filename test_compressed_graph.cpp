@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include "compressed_graph.hpp"
+#include "dot_helper.hpp"
+
+TEST(test_compressed_graph, matches_csr_neighbors)
+{
+    std::mt19937 rng(5);
+    // Large enough for multi-byte gaps and negative first gaps.
+    const int n = 100000;
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i < 200000; ++i)
+    {
+        edges.push_back({pick(rng), pick(rng)});
+    }
+    edges.push_back({7, 7});
+    edges.push_back({3, 9});
+    edges.push_back({9, 3});
+
+    auto csr = csr_graph<int>::from_edge_list(std::vector<int>(n, 0), edges);
+    compressed_graph<int> compressed(csr);
+    ASSERT_EQ(compressed.vertex_count(), n);
+    EXPECT_EQ(compressed.arc_count(), csr.arc_count());
+    EXPECT_LT(compressed.bytes_per_arc(), 4.0 + 8.0 * n / csr.arc_count());
+
+    std::vector<int> decoded;
+    for (int v = 0; v < n; ++v)
+    {
+        auto neighbors = csr.neighbors(v);
+        std::vector<int> expected(neighbors.begin(), neighbors.end());
+        std::sort(expected.begin(), expected.end());
+        compressed.decode_neighbors(v, decoded);
+        ASSERT_EQ(decoded, expected);
+        ASSERT_EQ(compressed.degree(v), csr.degree(v));
+    }
+}
+
+TEST(test_compressed_graph, algorithms_and_dot_run_unchanged)
+{
+    undirected_graph<int> graph;
+    for (int i = 0; i < 5; ++i)
+    {
+        graph.add_vertex(10 * i);
+    }
+    graph.set_edge_generator(3, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(1);
+        neighbors.append_element(0);
+        return neighbors; });
+
+    compressed_graph<int> compressed(graph);
+    EXPECT_EQ(compressed.vertex_data(4), 40);
+    csr_graph<int> csr(graph);
+    EXPECT_EQ(compressed.find_connected_components().get_length(), csr.find_connected_components().get_length());
+    EXPECT_EQ(compressed.find_component_labels(), csr.find_component_labels());
+
+    auto sorted = compressed_graph<int>::from_edge_list({10, 20, 30}, {{1, 2}, {0, 1}, {2, 2}});
+    EXPECT_EQ(to_dot(sorted), to_dot(csr_graph<int>::from_edge_list({10, 20, 30}, {{0, 1}, {1, 2}, {2, 2}})));
+
+    EXPECT_THROW(compressed.degree(5), std::out_of_range);
+    EXPECT_THROW(compressed_graph<int>::from_edge_list({0}, {{0, 1}}), std::out_of_range);
+}
+
+TEST(test_compressed_graph, consecutive_labels_take_about_a_byte_per_arc)
+{
+    const int n = 10000;
+    std::vector<std::pair<int, int>> edges;
+    for (int v = 0; v + 1 < n; ++v)
+    {
+        edges.push_back({v, v + 1});
+    }
+    auto compressed = compressed_graph<int>::from_edge_list(std::vector<int>(n, 0), edges);
+    // Degree, first gap and one more gap per vertex.
+    EXPECT_LE(compressed.adjacency_bytes() - (n + 1) * sizeof(std::size_t), static_cast<std::size_t>(3 * n));
+
+    compressed_graph<int> empty;
+    EXPECT_EQ(empty.vertex_count(), 0);
+    EXPECT_EQ(empty.bytes_per_arc(), 0.0);
+}
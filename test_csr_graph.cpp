@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+#include "csr_graph.hpp"
+#include "dot_helper.hpp"
+
+TEST(test_csr_graph, empty_graph)
+{
+    undirected_graph<int> graph;
+    csr_graph<int> csr(graph);
+
+    EXPECT_EQ(csr.vertex_count(), 0);
+    EXPECT_EQ(csr.arc_count(), 0u);
+    EXPECT_EQ(csr.find_connected_components().get_length(), 0);
+}
+
+TEST(test_csr_graph, snapshot_matches_generators)
+{
+    undirected_graph<int> graph;
+    for (int i = 0; i < 4; ++i)
+    {
+        graph.add_vertex(i * 100);
+    }
+
+    graph.set_edge_generator(0, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(1);
+        neighbors.append_element(2);
+        return neighbors; });
+
+    graph.set_edge_generator(1, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(0);
+        return neighbors; });
+
+    graph.set_edge_generator(2, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(0);
+        return neighbors; });
+
+    csr_graph<int> csr(graph);
+
+    EXPECT_EQ(csr.vertex_count(), 4);
+    EXPECT_EQ(csr.arc_count(), 4u);
+    EXPECT_EQ(csr.vertex_data(3), 300);
+    EXPECT_EQ(csr.degree(0), 2);
+    EXPECT_EQ(csr.degree(3), 0);
+
+    auto neighbors = csr.neighbors(0);
+    ASSERT_EQ(neighbors.size(), 2u);
+    EXPECT_EQ(neighbors[0], 1);
+    EXPECT_EQ(neighbors[1], 2);
+
+    auto components = csr.find_connected_components();
+    EXPECT_EQ(components.get_length(), 2);
+    EXPECT_EQ(components[0].get_length(), 3);
+    EXPECT_EQ(components[1].get(0), 3);
+}
+
+TEST(test_csr_graph, from_edge_list_symmetrizes)
+{
+    std::vector<std::pair<int, int>> edges = {{0, 1}, {1, 2}, {3, 4}, {5, 5}};
+    auto csr = csr_graph<int>::from_edge_list({0, 1, 2, 3, 4, 5}, edges);
+
+    EXPECT_EQ(csr.vertex_count(), 6);
+    EXPECT_EQ(csr.arc_count(), 7u);
+    EXPECT_EQ(csr.degree(1), 2);
+    EXPECT_EQ(csr.degree(5), 1);
+    EXPECT_EQ(csr.neighbors(4)[0], 3);
+
+    auto offsets = csr.offset_array();
+    ASSERT_EQ(offsets.size(), 7u);
+    EXPECT_EQ(offsets[0], 0u);
+    EXPECT_EQ(offsets[6], csr.target_array().size());
+
+    auto components = csr.find_connected_components();
+    EXPECT_EQ(components.get_length(), 3);
+    EXPECT_EQ(components[0].get_length(), 3);
+    EXPECT_EQ(components[1].get_length(), 2);
+    EXPECT_EQ(components[2].get_length(), 1);
+}
+
+TEST(test_csr_graph, invalid_vertex_ids_throw)
+{
+    std::vector<std::pair<int, int>> edges = {{0, 2}};
+    EXPECT_THROW(csr_graph<int>::from_edge_list({0, 1}, edges), std::out_of_range);
+
+    auto csr = csr_graph<int>::from_edge_list({0, 1}, {{0, 1}});
+    EXPECT_THROW(csr.neighbors(2), std::out_of_range);
+    EXPECT_THROW(csr.vertex_data(-1), std::out_of_range);
+}
+
+TEST(test_csr_graph, to_dot_matches_source_graph)
+{
+    undirected_graph<std::string> graph;
+    graph.add_vertex("A");
+    graph.add_vertex("B");
+    graph.add_vertex("C");
+
+    graph.set_edge_generator(0, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(1);
+        return neighbors; });
+
+    graph.set_edge_generator(1, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(0);
+        neighbors.append_element(2);
+        return neighbors; });
+
+    graph.set_edge_generator(2, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(1);
+        return neighbors; });
+
+    csr_graph<std::string> csr(graph);
+    EXPECT_EQ(to_dot(csr), to_dot(graph));
+}
+
+TEST(test_csr_graph, million_vertex_chain_with_reused_workspace)
+{
+    const int n = 1000000;
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i + 1 < n; ++i)
+    {
+        edges.push_back({i, i + 1});
+    }
+    auto csr = csr_graph<int>::from_edge_list(std::vector<int>(n, 0), edges);
+
+    components_workspace workspace;
+    auto labels = component_labels(csr, workspace);
+    ASSERT_EQ(labels.size(), static_cast<std::size_t>(n));
+    EXPECT_EQ(labels.front(), 0);
+    EXPECT_EQ(labels.back(), 0);
+
+    auto components = connected_components(csr, workspace);
+    EXPECT_EQ(components.get_length(), 1);
+    EXPECT_EQ(components[0].get_length(), n);
+}
+
+TEST(test_csr_graph, workspace_on_caller_arena)
+{
+    auto csr = csr_graph<int>::from_edge_list({0, 1, 2, 3, 4}, {{0, 1}, {1, 2}, {3, 4}});
+
+    // All scratch must fit in the local buffer; the null upstream throws otherwise.
+    std::byte buffer[1024];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    components_workspace workspace(&arena);
+
+    EXPECT_EQ(component_labels(csr, workspace), (std::vector<int>{0, 0, 0, 1, 1}));
+    EXPECT_EQ(connected_components(csr, workspace).get_length(), 2);
+}
+
+TEST(test_csr_graph, weighted_edges_stay_parallel_to_targets)
+{
+    auto csr = csr_graph<int, double>::from_weighted_edge_list({0, 1, 2}, {{0, 1, 1.5}, {1, 2, 2.5}, {2, 2, 4.0}});
+
+    ASSERT_EQ(csr.arc_count(), 5u);
+    ASSERT_EQ(csr.weight_array().size(), csr.target_array().size());
+
+    std::vector<std::pair<int, double>> seen;
+    for (auto [target, weight] : csr.edges(1))
+    {
+        seen.push_back({target, weight});
+    }
+    EXPECT_EQ(seen, (std::vector<std::pair<int, double>>{{0, 1.5}, {2, 2.5}}));
+
+    double total = 0.0;
+    csr.for_each_edge(2, [&](int, double weight)
+                      { total += weight; });
+    EXPECT_DOUBLE_EQ(total, 6.5);
+    EXPECT_THROW(csr.edges(3), std::out_of_range);
+}
+
+TEST(test_csr_graph, weighted_snapshot_of_undirected_graph)
+{
+    undirected_graph<std::string, int> graph;
+    graph.add_vertex("a");
+    graph.add_vertex("b");
+    graph.add_vertex("c");
+    graph.set_edge_generator(0, []()
+                             {
+        list_sequence<edge<int>> out;
+        out.append_element(edge<int>(1, 7));
+        return out; });
+    graph.set_edge_generator(1, []()
+                             {
+        list_sequence<edge<int>> out;
+        out.append_element(edge<int>(0, 7));
+        return out; });
+
+    EXPECT_EQ(graph.find_connected_components().get_length(), 2);
+    EXPECT_EQ(graph.neighbors(1).get_length(), 1);
+
+    csr_graph<std::string, int> csr(graph);
+    ASSERT_EQ(csr.arc_count(), 2u);
+    EXPECT_EQ((*csr.edges(0).begin()).weight, 7);
+    EXPECT_EQ(csr.find_component_labels(), graph.find_component_labels());
+
+    graph.set_cache_config({cache_policy::materialize});
+    int weight = 0;
+    graph.for_each_edge(1, [&](int, int w)
+                        { weight = w; });
+    EXPECT_EQ(weight, 7);
+}
+
+TEST(test_csr_graph, weights_validated_and_free_when_unweighted)
+{
+    EXPECT_THROW((csr_graph<int, float>({0, 1}, {0, 1, 2}, {1, 0}, {1.0f})), std::invalid_argument);
+    EXPECT_NO_THROW((csr_graph<int, float>({0, 1}, {0, 1, 2}, {1, 0}, {1.0f, 1.0f})));
+
+    static_assert(sizeof(csr_graph<int>) < sizeof(csr_graph<int, float>));
+    int arcs = 0;
+    csr_graph<int>::from_edge_list({0, 1}, {{0, 1}}).for_each_edge(0, [&](int, std::monostate)
+                                                                   { ++arcs; });
+    EXPECT_EQ(arcs, 1);
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "connected_components.hpp"
+#include "csr_graph.hpp"
+#include "distributed_components.hpp"
+#include "graph_builder.hpp"
+#include "graph_generators.hpp"
+#include "undirected_graph.hpp"
+
+TEST(test_distributed_components, in_process_and_forked_shards_match_traversal)
+{
+    std::mt19937 rng(59);
+    const int n = 2000;
+    // Sparse enough to leave many components, some spanning every shard.
+    auto edges = erdos_renyi_edges(n, 1.2 / n, rng);
+    auto path = path_edges(200);
+    edges.insert(edges.end(), path.begin(), path.end());
+    auto graph = build_undirected_graph(std::vector<int>(n, 0), edges);
+    std::vector<int> expected = component_labels(graph);
+
+    for (partition_method method : {partition_method::ldg, partition_method::fennel})
+    {
+        for (int k : {1, 3, 5})
+        {
+            std::vector<graph_shard> shards = build_shards(graph, partition_graph(graph, k, {method}));
+
+            distributed_components_result local = distributed_component_labels(shards);
+            EXPECT_EQ(local.labels, expected);
+            EXPECT_GE(local.rounds, 1);
+            if (k == 1)
+            {
+                EXPECT_EQ(local.messages, 0);
+            }
+
+            distributed_components_result forked = sharded_component_labels(shards);
+            EXPECT_EQ(forked.labels, expected);
+            EXPECT_EQ(forked.rounds, local.rounds);
+            EXPECT_EQ(forked.messages, local.messages);
+        }
+    }
+}
+
+TEST(test_distributed_components, alternating_owners_settle_through_ghosts)
+{
+    // Every path edge crosses shards, but each shard's ghosts link its own
+    // vertices into one local component, so two rounds are enough.
+    const int n = 40;
+    auto csr = build_csr_graph(std::vector<int>(n, 0), path_edges(n));
+    graph_partition partition;
+    partition.shard_count = 2;
+    partition.shard_sizes = {n / 2, n / 2};
+    for (int v = 0; v < n; ++v)
+    {
+        partition.shard_of.push_back(v % 2);
+    }
+    std::vector<graph_shard> shards = build_shards(csr, partition);
+    EXPECT_EQ(shards[0].ghost_count(), n / 2);
+
+    distributed_components_result result = sharded_component_labels(shards);
+    EXPECT_EQ(result.labels, std::vector<int>(n, 0));
+    EXPECT_LE(result.rounds, 3);
+
+    graph_partition broken = partition;
+    broken.shard_of[3] = 2;
+    EXPECT_THROW(build_shards(csr, broken), std::invalid_argument);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "dot_helper.hpp"
+
+TEST(test_dot_writer, writes_vertices_and_each_edge_once)
+{
+    auto graph = csr_graph<int>::from_edge_list({10, 20, 30}, {{0, 1}, {1, 2}, {2, 2}});
+
+    EXPECT_EQ(to_dot(graph),
+              "graph G {\n"
+              "    node [shape=circle, style=filled, fillcolor=lightblue, fontname=\"Arial\"];\n"
+              "    edge [color=gray40];\n"
+              "    0 [label=\"0: 10\"];\n"
+              "    1 [label=\"1: 20\"];\n"
+              "    2 [label=\"2: 30\"];\n"
+              "    0 -- 1;\n"
+              "    1 -- 2;\n"
+              "}\n");
+}
+
+TEST(test_dot_writer, escapes_quotes_in_labels)
+{
+    auto graph = csr_graph<std::string>::from_edge_list({"say \"hi\"", "\"\""}, {});
+
+    std::string dot = to_dot(graph);
+    EXPECT_NE(dot.find("0 [label=\"0: say \\\"hi\\\"\"];"), std::string::npos);
+    EXPECT_NE(dot.find("1 [label=\"1: \\\"\\\"\"];"), std::string::npos);
+}
+
+TEST(test_dot_writer, numbers_match_to_string)
+{
+    auto graph = csr_graph<double>::from_edge_list({1.5, -2.0}, {});
+
+    std::string dot = to_dot(graph);
+    EXPECT_NE(dot.find("0: " + std::to_string(1.5)), std::string::npos);
+    EXPECT_NE(dot.find("1: " + std::to_string(-2.0)), std::string::npos);
+}
+
+TEST(test_dot_writer, small_buffer_and_sinks_agree)
+{
+    std::vector<int> payloads(500);
+    std::vector<std::pair<int, int>> edges;
+    for (int v = 0; v + 1 < 500; ++v)
+    {
+        payloads[v] = v * 7;
+        edges.push_back({v, v + 1});
+    }
+    auto graph = csr_graph<int>::from_edge_list(payloads, edges);
+    std::string expected = to_dot(graph);
+
+    std::string tiny;
+    {
+        buffered_output out(tiny, 16);
+        write_dot(graph, out);
+    }
+    EXPECT_EQ(tiny, expected);
+
+    std::ostringstream stream;
+    write_dot(graph, stream);
+    EXPECT_EQ(stream.str(), expected);
+
+    std::string path = ::testing::TempDir() + "writer.dot";
+    export_to_dot(graph, path);
+    std::ifstream in(path, std::ios::binary);
+    std::string written((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(written, expected);
+    std::remove(path.c_str());
+}
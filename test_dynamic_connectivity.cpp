@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include "csr_graph.hpp"
+#include "dynamic_connectivity.hpp"
+#include "level_spanning_forest.hpp"
+
+TEST(test_dynamic_connectivity, follows_generator_updates_both_ways)
+{
+    undirected_graph<int> graph;
+    for (int i = 0; i < 4; ++i)
+    {
+        graph.add_vertex(i);
+    }
+    dynamic_connectivity<int> connectivity(graph);
+    EXPECT_EQ(connectivity.component_count(), 4);
+
+    graph.set_edge_generator(0, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(1);
+        neighbors.append_element(2);
+        return neighbors; });
+    EXPECT_TRUE(connectivity.connected(1, 2));
+    EXPECT_EQ(connectivity.component_size(2), 3);
+
+    // Rewiring 0 from {1, 2} to {3} splits 1 and 2 off.
+    graph.set_edge_generator(0, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(3);
+        return neighbors; });
+    EXPECT_FALSE(connectivity.connected(0, 1));
+    EXPECT_FALSE(connectivity.connected(1, 2));
+    EXPECT_TRUE(connectivity.connected(0, 3));
+    EXPECT_EQ(connectivity.component_count(), 3);
+
+    int v = graph.add_vertex(4);
+    graph.set_edge_generator(v, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(1);
+        return neighbors; });
+    EXPECT_TRUE(connectivity.connected(1, 4));
+
+    graph.set_edge_generator(v, []()
+                             { return list_sequence<int>(); });
+    EXPECT_FALSE(connectivity.connected(1, 4));
+    EXPECT_EQ(connectivity.component_count(), 4);
+
+    EXPECT_THROW(connectivity.connected(0, 5), std::out_of_range);
+}
+
+TEST(test_dynamic_connectivity, edge_listed_from_both_sides_survives_one_removal)
+{
+    undirected_graph<int> graph;
+    for (int i = 0; i < 2; ++i)
+    {
+        graph.add_vertex(i);
+    }
+    graph.set_edge_generator(0, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(1);
+        return neighbors; });
+    graph.set_edge_generator(1, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(0);
+        return neighbors; });
+
+    dynamic_connectivity<int> connectivity(graph);
+    graph.set_edge_generator(0, []()
+                             { return list_sequence<int>(); });
+    EXPECT_TRUE(connectivity.connected(0, 1));
+    graph.set_edge_generator(1, []()
+                             { return list_sequence<int>(); });
+    EXPECT_FALSE(connectivity.connected(0, 1));
+}
+
+TEST(test_dynamic_connectivity, parallel_edges_self_loops_and_missing_edges)
+{
+    level_spanning_forest forest(3);
+    EXPECT_TRUE(forest.insert_edge(0, 1));
+    EXPECT_FALSE(forest.insert_edge(1, 0));
+    EXPECT_FALSE(forest.insert_edge(2, 2));
+    EXPECT_EQ(forest.component_count(), 2);
+
+    EXPECT_FALSE(forest.delete_edge(0, 1));
+    EXPECT_TRUE(forest.connected(0, 1));
+    EXPECT_TRUE(forest.delete_edge(0, 1));
+    EXPECT_FALSE(forest.connected(0, 1));
+    EXPECT_EQ(forest.component_count(), 3);
+
+    EXPECT_THROW(forest.delete_edge(0, 1), std::invalid_argument);
+    EXPECT_THROW(forest.insert_edge(0, 3), std::out_of_range);
+}
+
+TEST(test_dynamic_connectivity, random_updates_match_dfs)
+{
+    std::mt19937 rng(17);
+    for (int trial = 0; trial < 6; ++trial)
+    {
+        const int n = 40 + 30 * trial;
+        std::uniform_int_distribution<int> pick(0, n - 1);
+        level_spanning_forest forest(n);
+        std::vector<std::pair<int, int>> present;
+
+        for (int step = 0; step < 3000; ++step)
+        {
+            // Keep the edge count near n so components keep splitting and
+            // merging instead of settling into one giant tree.
+            bool insert = present.empty() || (rng() % 2 == 0 && static_cast<int>(present.size()) < n * 3 / 2);
+            if (insert)
+            {
+                std::pair<int, int> e{pick(rng), pick(rng)};
+                forest.insert_edge(e.first, e.second);
+                present.push_back(e);
+            }
+            else
+            {
+                std::size_t i = rng() % present.size();
+                forest.delete_edge(present[i].first, present[i].second);
+                present[i] = present.back();
+                present.pop_back();
+            }
+
+            if (step % 50 != 0)
+            {
+                continue;
+            }
+            auto csr = csr_graph<int>::from_edge_list(std::vector<int>(n, 0), present);
+            auto expected = component_labels(csr);
+            ASSERT_EQ(forest.component_count(), csr.find_connected_components().get_length());
+            for (int q = 0; q < 200; ++q)
+            {
+                int a = pick(rng);
+                int b = pick(rng);
+                ASSERT_EQ(forest.connected(a, b), expected[a] == expected[b]);
+            }
+        }
+        EXPECT_LE(forest.level_count(), 1 + static_cast<int>(std::log2(n)) + 1);
+    }
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "graph_builder.hpp"
+
+TEST(test_graph_builder, symmetrizes_and_deduplicates)
+{
+    std::vector<std::pair<int, int>> edges = {{0, 1}, {1, 0}, {0, 1}, {2, 1}, {3, 3}, {3, 3}};
+    auto graph = build_csr_graph<int>({10, 11, 12, 13}, edges);
+
+    EXPECT_EQ(graph.vertex_count(), 4);
+    EXPECT_EQ(graph.vertex_data(2), 12);
+    ASSERT_EQ(graph.degree(0), 1);
+    ASSERT_EQ(graph.degree(1), 2);
+    EXPECT_EQ(graph.neighbors(1)[0], 0);
+    EXPECT_EQ(graph.neighbors(1)[1], 2);
+    ASSERT_EQ(graph.degree(3), 1);
+    EXPECT_EQ(graph.neighbors(3)[0], 3);
+    EXPECT_EQ(graph.arc_count(), 5u);
+}
+
+TEST(test_graph_builder, options_control_symmetry_and_self_loops)
+{
+    std::vector<std::pair<int, int>> edges = {{0, 1}, {0, 1}, {2, 2}};
+
+    build_options options;
+    options.symmetrize = false;
+    options.deduplicate = false;
+    options.drop_self_loops = true;
+    auto graph = build_csr_graph<int>({0, 1, 2}, edges, options);
+
+    EXPECT_EQ(graph.degree(0), 2);
+    EXPECT_EQ(graph.degree(1), 0);
+    EXPECT_EQ(graph.degree(2), 0);
+}
+
+TEST(test_graph_builder, invalid_edge_throws)
+{
+    std::vector<std::pair<int, int>> edges = {{0, 3}};
+    EXPECT_THROW(build_csr_graph<int>({0, 1, 2}, edges), std::out_of_range);
+}
+
+TEST(test_graph_builder, parallel_build_matches_sequential)
+{
+    const int n = 3000;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i < 40000; ++i)
+    {
+        edges.push_back({pick(rng), pick(rng)});
+    }
+
+    auto sequential = build_csr_graph<int>(std::vector<int>(n, 0), edges);
+    build_options options;
+    options.thread_count = 4;
+    auto parallel = build_csr_graph<int>(std::vector<int>(n, 0), edges, options);
+
+    ASSERT_EQ(parallel.arc_count(), sequential.arc_count());
+    for (int v = 0; v < n; ++v)
+    {
+        auto expected = sequential.neighbors(v);
+        auto actual = parallel.neighbors(v);
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(), actual.begin(), actual.end()));
+    }
+}
+
+TEST(test_graph_builder, builds_generator_graph)
+{
+    std::vector<std::pair<int, int>> edges = {{0, 1}, {1, 2}, {3, 4}};
+    auto graph = build_undirected_graph<std::string>({"a", "b", "c", "d", "e"}, edges);
+
+    EXPECT_EQ(graph.vertex_count(), 5);
+    EXPECT_EQ(graph.vertex_data(4), "e");
+    EXPECT_EQ(graph.neighbors(1).get_length(), 2);
+    EXPECT_EQ(graph.find_connected_components().get_length(), 2);
+}
+
+TEST(test_graph_builder, csr_constructor_validates_arrays)
+{
+    EXPECT_THROW(csr_graph<int>({0, 1}, {0, 1}, {1}), std::invalid_argument);
+    EXPECT_THROW(csr_graph<int>({0, 1}, {0, 2, 1}, {1}), std::invalid_argument);
+    EXPECT_THROW(csr_graph<int>({0, 1}, {0, 1, 1}, {5}), std::out_of_range);
+    EXPECT_NO_THROW(csr_graph<int>({0, 1}, {0, 1, 2}, {1, 0}));
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include "graph_builder.hpp"
+#include "graph_file.hpp"
+
+namespace
+{
+    std::string temp_path(const std::string &name)
+    {
+        return ::testing::TempDir() + name;
+    }
+
+    csr_graph<int> sample_graph()
+    {
+        std::mt19937 rng(3);
+        std::uniform_int_distribution<int> pick(0, 499);
+        std::vector<std::pair<int, int>> edges;
+        for (int i = 0; i < 2000; ++i)
+        {
+            edges.push_back({pick(rng), pick(rng)});
+        }
+        std::vector<int> payloads(500);
+        for (int i = 0; i < 500; ++i)
+        {
+            payloads[i] = i * 7;
+        }
+        return build_csr_graph(std::move(payloads), std::span<const std::pair<int, int>>(edges));
+    }
+
+    void flip_byte(const std::string &path, std::streamoff position)
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(position);
+        char byte = 0;
+        file.read(&byte, 1);
+        byte ^= 0x5A;
+        file.seekp(position);
+        file.write(&byte, 1);
+    }
+}
+
+TEST(test_graph_file, round_trip_preserves_graph)
+{
+    auto graph = sample_graph();
+    std::string path = temp_path("round_trip.ugraph");
+    save_graph_file(graph, path);
+
+    auto loaded = load_graph_file<int>(path);
+    ASSERT_EQ(loaded.vertex_count(), graph.vertex_count());
+    ASSERT_EQ(loaded.arc_count(), graph.arc_count());
+    for (int v = 0; v < graph.vertex_count(); ++v)
+    {
+        EXPECT_EQ(loaded.vertex_data(v), graph.vertex_data(v));
+        auto expected = graph.neighbors(v);
+        auto actual = loaded.neighbors(v);
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(), actual.begin(), actual.end()));
+    }
+    EXPECT_EQ(loaded.find_component_labels(), graph.find_component_labels());
+
+    auto lazy = load_graph_file<int>(path, {false, false});
+    EXPECT_EQ(lazy.arc_count(), graph.arc_count());
+
+    std::remove(path.c_str());
+}
+
+TEST(test_graph_file, loaded_graph_outlives_copies)
+{
+    std::string path = temp_path("copies.ugraph");
+    save_graph_file(sample_graph(), path);
+
+    csr_graph<int> copy;
+    {
+        auto loaded = load_graph_file<int>(path);
+        copy = loaded;
+    }
+    std::remove(path.c_str());
+
+    EXPECT_EQ(copy.vertex_count(), 500);
+    EXPECT_EQ(copy.vertex_data(3), 21);
+}
+
+TEST(test_graph_file, empty_graph_and_non_trivial_payloads)
+{
+    std::string path = temp_path("empty.ugraph");
+    save_graph_file(csr_graph<int>(), path);
+    EXPECT_EQ(load_graph_file<int>(path).vertex_count(), 0);
+
+    auto labelled = csr_graph<std::string>::from_edge_list({"a", "b", "c"}, {{0, 1}});
+    save_graph_file(labelled, path);
+    auto loaded = load_graph_file<std::string>(path);
+    EXPECT_EQ(loaded.vertex_count(), 3);
+    EXPECT_EQ(loaded.vertex_data(0), "");
+    EXPECT_EQ(loaded.degree(1), 1);
+
+    std::remove(path.c_str());
+}
+
+TEST(test_graph_file, rejects_corruption)
+{
+    std::string path = temp_path("corrupt.ugraph");
+    save_graph_file(sample_graph(), path);
+
+    EXPECT_THROW(load_graph_file<double>(path), std::runtime_error);
+
+    flip_byte(path, 200);
+    EXPECT_THROW(load_graph_file<int>(path), std::runtime_error);
+
+    flip_byte(path, 200);
+    EXPECT_NO_THROW(load_graph_file<int>(path));
+
+    flip_byte(path, 20);
+    EXPECT_THROW(load_graph_file<int>(path, {false, false}), std::runtime_error);
+
+    std::remove(path.c_str());
+    EXPECT_THROW(load_graph_file<int>(path), std::runtime_error);
+}
+
+TEST(test_graph_file, rejects_truncated_file)
+{
+    std::string path = temp_path("truncated.ugraph");
+    save_graph_file(sample_graph(), path);
+    ::truncate(path.c_str(), 4096);
+    EXPECT_THROW(load_graph_file<int>(path, {false, false}), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(test_graph_file, rejects_forged_counts_with_valid_checksum)
+{
+    std::string path = temp_path("forged.ugraph");
+    auto forge = [&](auto &&edit)
+    {
+        save_graph_file(sample_graph(), path);
+        graph_file::header h;
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.read(reinterpret_cast<char *>(&h), sizeof(h));
+        edit(h);
+        h.header_checksum = graph_file::header_checksum(h);
+        file.seekp(0);
+        file.write(reinterpret_cast<const char *>(&h), sizeof(h));
+    };
+
+    // arc_count * 4 wraps to 0, matching an empty targets section; the last
+    // offset is rewritten to agree with the forged count.
+    forge([&](graph_file::header &h)
+          {
+        const std::uint64_t arcs = 1ull << 62;
+        h.arc_count = arcs;
+        h.sections[graph_file::targets_section].bytes = 0;
+        h.sections[graph_file::targets_section].checksum = graph_file::checksum(nullptr, 0);
+
+        graph_file::section_entry &offsets = h.sections[graph_file::offsets_section];
+        std::vector<std::uint64_t> values(offsets.bytes / sizeof(std::uint64_t));
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(offsets.position);
+        file.read(reinterpret_cast<char *>(values.data()), offsets.bytes);
+        values.back() = arcs;
+        file.seekp(offsets.position);
+        file.write(reinterpret_cast<const char *>(values.data()), offsets.bytes);
+        offsets.checksum = graph_file::checksum(values.data(), offsets.bytes); });
+    EXPECT_THROW(load_graph_file<int>(path), std::runtime_error);
+
+    forge([](graph_file::header &h)
+          { h.payload_size = 1u << 31; });
+    EXPECT_THROW(load_graph_file<int>(path), std::runtime_error);
+
+    std::remove(path.c_str());
+}
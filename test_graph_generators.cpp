@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include "graph_generators.hpp"
+
+namespace
+{
+    void expect_simple(const std::vector<std::pair<int, int>> &edges, int n)
+    {
+        std::set<std::pair<int, int>> seen;
+        for (auto [u, v] : edges)
+        {
+            ASSERT_GE(u, 0);
+            ASSERT_LT(u, n);
+            ASSERT_GE(v, 0);
+            ASSERT_LT(v, n);
+            ASSERT_NE(u, v);
+            ASSERT_TRUE(seen.insert({std::min(u, v), std::max(u, v)}).second);
+        }
+    }
+}
+
+TEST(test_graph_generators, erdos_renyi_is_simple_and_near_expected_size)
+{
+    std::mt19937 rng(1);
+    const int n = 2000;
+    const double p = 0.01;
+    auto edges = erdos_renyi_edges(n, p, rng);
+    expect_simple(edges, n);
+    double expected = p * n * (n - 1) / 2;
+    EXPECT_NEAR(static_cast<double>(edges.size()), expected, expected * 0.1);
+
+    EXPECT_TRUE(erdos_renyi_edges(n, 0.0, rng).empty());
+    EXPECT_EQ(erdos_renyi_edges(10, 1.0, rng).size(), 45u);
+}
+
+TEST(test_graph_generators, rmat_has_requested_size_and_is_deterministic)
+{
+    std::mt19937 first(7);
+    std::mt19937 second(7);
+    auto edges = rmat_edges(10, 8, first);
+    EXPECT_EQ(edges.size(), 8u * 1024);
+    for (auto [u, v] : edges)
+    {
+        ASSERT_GE(u, 0);
+        ASSERT_LT(u, 1024);
+        ASSERT_GE(v, 0);
+        ASSERT_LT(v, 1024);
+    }
+    EXPECT_EQ(edges, rmat_edges(10, 8, second));
+
+    std::mt19937 rng(7);
+    EXPECT_THROW(rmat_edges(10, 8, rng, 0.6, 0.3, 0.3), std::invalid_argument);
+    EXPECT_THROW(rmat_edges(-1, 8, rng), std::invalid_argument);
+}
+
+TEST(test_graph_generators, barabasi_albert_links_each_vertex_to_distinct_targets)
+{
+    std::mt19937 rng(3);
+    const int n = 1000;
+    const int k = 4;
+    auto edges = barabasi_albert_edges(n, k, rng);
+    expect_simple(edges, n);
+    EXPECT_EQ(edges.size(), static_cast<std::size_t>(k * (k + 1) / 2 + (n - k - 1) * k));
+    for (auto [u, v] : edges)
+    {
+        ASSERT_GT(u, v);
+    }
+
+    EXPECT_THROW(barabasi_albert_edges(3, 4, rng), std::invalid_argument);
+    EXPECT_THROW(barabasi_albert_edges(10, 0, rng), std::invalid_argument);
+}
+
+TEST(test_graph_generators, grid_and_path)
+{
+    auto grid = grid_edges(3, 4);
+    expect_simple(grid, 12);
+    EXPECT_EQ(grid.size(), 3u * 3 + 2u * 4);
+
+    auto path = path_edges(5);
+    EXPECT_EQ(path, (std::vector<std::pair<int, int>>{{0, 1}, {1, 2}, {2, 3}, {3, 4}}));
+    EXPECT_TRUE(path_edges(1).empty());
+    EXPECT_TRUE(grid_edges(0, 5).empty());
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include "csr_graph.hpp"
+#include "graph_builder.hpp"
+#include "graph_generators.hpp"
+#include "graph_partition.hpp"
+
+TEST(test_graph_partition, streaming_partitioners_are_balanced_and_cut_few_grid_edges)
+{
+    auto grid = build_csr_graph(std::vector<int>(64 * 64, 0), grid_edges(64, 64));
+    for (partition_method method : {partition_method::ldg, partition_method::fennel})
+    {
+        for (int k : {1, 2, 4, 7})
+        {
+            graph_partition partition = partition_graph(grid, k, {method, 1.1, 1.5});
+            ASSERT_EQ(partition.shard_count, k);
+            ASSERT_EQ(static_cast<int>(partition.shard_of.size()), grid.vertex_count());
+
+            std::vector<int> sizes(k, 0);
+            for (int shard : partition.shard_of)
+            {
+                ASSERT_GE(shard, 0);
+                ASSERT_LT(shard, k);
+                ++sizes[shard];
+            }
+            EXPECT_EQ(sizes, partition.shard_sizes);
+
+            partition_quality quality = evaluate_partition(grid, partition);
+            EXPECT_EQ(quality.arcs, static_cast<long long>(grid.arc_count()));
+            // Capacity is rounded up to whole vertices.
+            EXPECT_LE(quality.imbalance, std::ceil(1.1 * grid.vertex_count() / k) / (grid.vertex_count() / double(k)));
+            // A random assignment would cut (k - 1) / k of the arcs.
+            if (k > 1)
+            {
+                EXPECT_LT(quality.cut_fraction, 0.5 * (k - 1.0) / k);
+            }
+            else
+            {
+                EXPECT_EQ(quality.cut_arcs, 0);
+            }
+        }
+    }
+
+    EXPECT_THROW(partition_graph(grid, 0), std::invalid_argument);
+    EXPECT_THROW(partition_graph(grid, 2, {partition_method::ldg, 0.9, 1.5}), std::invalid_argument);
+    EXPECT_THROW(partition_graph(grid, 2, {partition_method::fennel, 1.1, 1.0}), std::invalid_argument);
+}
+
+TEST(test_graph_partition, shards_keep_every_arc_and_mirror_every_ghost)
+{
+    std::mt19937 rng(53);
+    auto edges = erdos_renyi_edges(300, 0.02, rng);
+    auto csr = build_csr_graph(std::vector<int>(300, 0), edges);
+    graph_partition partition = partition_graph(csr, 3, {partition_method::ldg});
+    std::vector<graph_shard> shards = build_shards(csr, partition);
+    ASSERT_EQ(shards.size(), 3u);
+
+    std::multiset<std::pair<int, int>> expected;
+    for (int v = 0; v < csr.vertex_count(); ++v)
+    {
+        for (int u : csr.neighbors(v))
+        {
+            expected.insert({v, u});
+        }
+    }
+
+    std::multiset<std::pair<int, int>> seen;
+    std::set<int> owned;
+    for (const graph_shard &shard : shards)
+    {
+        EXPECT_EQ(shard.owned_count, partition.shard_sizes[shard.shard_id]);
+        for (int v = 0; v < shard.vertex_count(); ++v)
+        {
+            int global = shard.global_id(v);
+            EXPECT_EQ(shard.owner(v), partition.shard_of[global]);
+            EXPECT_EQ(shard.is_ghost(v), partition.shard_of[global] != shard.shard_id);
+            if (!shard.is_ghost(v))
+            {
+                EXPECT_TRUE(owned.insert(global).second);
+            }
+            shard.for_each_neighbor(v, [&](int u)
+                                    { seen.insert({global, shard.global_id(u)}); });
+        }
+        for (const graph_shard::mirror &m : shard.mirrors)
+        {
+            const graph_shard &holder = shards[m.shard];
+            ASSERT_TRUE(holder.is_ghost(m.remote_id));
+            EXPECT_EQ(holder.global_id(m.remote_id), shard.global_id(m.local_id));
+        }
+    }
+    EXPECT_EQ(static_cast<int>(owned.size()), csr.vertex_count());
+    EXPECT_EQ(seen, expected);
+
+    int ghosts = 0;
+    int mirrors = 0;
+    for (const graph_shard &shard : shards)
+    {
+        ghosts += shard.ghost_count();
+        mirrors += static_cast<int>(shard.mirrors.size());
+    }
+    EXPECT_EQ(ghosts, mirrors);
+    EXPECT_THROW(shards[0].for_each_neighbor(shards[0].vertex_count(), [](int) {}), std::out_of_range);
+}
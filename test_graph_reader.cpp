@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include "graph_reader.hpp"
+#include "dot_helper.hpp"
+
+namespace
+{
+    std::string write_temp(const std::string &name, const std::string &content)
+    {
+        std::string path = ::testing::TempDir() + name;
+        std::ofstream out(path, std::ios::binary);
+        out << content;
+        return path;
+    }
+}
+
+TEST(test_graph_reader, snap_edge_list)
+{
+    std::string path = write_temp("snap.txt",
+                                  "# Directed graph: example\n"
+                                  "# FromNodeId\tToNodeId\n"
+                                  "0\t1\n"
+                                  "1\t2\n"
+                                  "\n"
+                                  "4\t5\n");
+    auto graph = read_edge_list(path);
+
+    EXPECT_EQ(graph.vertex_count(), 6);
+    EXPECT_EQ(graph.vertex_data(5), 5);
+    EXPECT_EQ(graph.degree(1), 2);
+    EXPECT_EQ(graph.degree(3), 0);
+    EXPECT_EQ(graph.find_connected_components().get_length(), 3);
+    std::remove(path.c_str());
+}
+
+TEST(test_graph_reader, csv_with_header_weights_and_remap)
+{
+    std::string path = write_temp("edges.csv",
+                                  "source,target,weight\r\n"
+                                  "1000000000000,42,0.5\r\n"
+                                  "42;7;1.5\r\n"
+                                  "% comment\r\n"
+                                  "7 , 1000000000000\r\n"
+                                  "99,100");
+
+    edge_list_options options;
+    options.has_header = true;
+    options.remap_ids = true;
+    auto graph = read_edge_list(path, options);
+
+    ASSERT_EQ(graph.vertex_count(), 5);
+    EXPECT_EQ(graph.vertex_data(0), 1000000000000ll);
+    EXPECT_EQ(graph.vertex_data(1), 42);
+    EXPECT_EQ(graph.vertex_data(4), 100);
+    EXPECT_EQ(graph.degree(0), 2);
+    EXPECT_EQ(graph.find_connected_components().get_length(), 2);
+    std::remove(path.c_str());
+}
+
+TEST(test_graph_reader, malformed_edge_list_reports_line)
+{
+    std::string path = write_temp("bad.txt", "0 1\n2 x\n");
+    try
+    {
+        read_edge_list(path);
+        FAIL() << "expected an exception";
+    }
+    catch (const std::runtime_error &error)
+    {
+        EXPECT_NE(std::string(error.what()).find("line 2"), std::string::npos);
+    }
+
+    std::string sparse = write_temp("sparse.txt", "0 99999999999\n");
+    EXPECT_THROW(read_edge_list(sparse), std::runtime_error);
+    EXPECT_THROW(read_edge_list(::testing::TempDir() + "missing.txt"), std::runtime_error);
+    std::remove(path.c_str());
+    std::remove(sparse.c_str());
+}
+
+TEST(test_graph_reader, lines_longer_than_buffer)
+{
+    std::string line(5000, ' ');
+    std::string path = write_temp("long.txt", line + "3 4\n" + line + "4 5\n");
+
+    chunked_reader reader(path, 64);
+    std::string_view view;
+    int lines = 0;
+    while (reader.next_line(view))
+    {
+        ++lines;
+        EXPECT_EQ(view.size(), line.size() + 3);
+    }
+    EXPECT_EQ(lines, 2);
+    EXPECT_EQ(read_edge_list(path).degree(4), 2);
+    std::remove(path.c_str());
+}
+
+TEST(test_graph_reader, dot_subset)
+{
+    std::string path = write_temp("subset.dot",
+                                  "strict graph \"net\" {\n"
+                                  "  rankdir = LR; // comment\n"
+                                  "  node [shape=box];\n"
+                                  "  a [label=\"Alpha \\\"A\\\"\"];\n"
+                                  "  a -- b -- c [color=red];\n"
+                                  "  /* block\n comment */\n"
+                                  "  d; e -- \"f g\"\n"
+                                  "}\n");
+    auto graph = read_dot(path);
+
+    ASSERT_EQ(graph.vertex_count(), 6);
+    EXPECT_EQ(graph.vertex_data(0), "Alpha \"A\"");
+    EXPECT_EQ(graph.vertex_data(1), "b");
+    EXPECT_EQ(graph.vertex_data(5), "f g");
+    EXPECT_EQ(graph.degree(1), 2);
+    EXPECT_EQ(graph.find_connected_components().get_length(), 3);
+    std::remove(path.c_str());
+}
+
+TEST(test_graph_reader, dot_round_trip)
+{
+    auto original = csr_graph<std::string>::from_edge_list({"A", "B \"b\"", "C", "D"}, {{0, 1}, {1, 2}});
+    std::string path = write_temp("round_trip.dot", to_dot(original));
+
+    auto graph = read_dot(path);
+    ASSERT_EQ(graph.vertex_count(), 4);
+    EXPECT_EQ(graph.vertex_data(1), "1: B \"b\"");
+    EXPECT_EQ(to_dot(graph), to_dot(csr_graph<std::string>::from_edge_list(
+                                 {"0: A", "1: B \"b\"", "2: C", "3: D"}, {{0, 1}, {1, 2}})));
+    std::remove(path.c_str());
+}
+
+TEST(test_graph_reader, dot_rejects_unsupported_input)
+{
+    std::string directed = write_temp("directed.dot", "digraph { a -> b }");
+    EXPECT_THROW(read_dot(directed), std::runtime_error);
+
+    std::string unterminated = write_temp("unterminated.dot", "graph { a -- b");
+    EXPECT_THROW(read_dot(unterminated), std::runtime_error);
+
+    std::string subgraph = write_temp("subgraph.dot", "graph { subgraph x { a } }");
+    EXPECT_THROW(read_dot(subgraph), std::runtime_error);
+
+    std::remove(directed.c_str());
+    std::remove(unterminated.c_str());
+    std::remove(subgraph.c_str());
+}
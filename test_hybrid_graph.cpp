@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include "hybrid_graph.hpp"
+#include "dot_helper.hpp"
+#include "shortest_paths.hpp"
+
+namespace
+{
+    // Random graph where one vertex in 50 is a hub adjacent to half
+    // of the others, so both layouts appear under `automatic`.
+    csr_graph<int> mixed_density_graph(int n, std::mt19937 &rng)
+    {
+        std::uniform_int_distribution<int> pick(0, n - 1);
+        std::vector<std::pair<int, int>> edges;
+        for (int v = 0; v < n; ++v)
+        {
+            int degree = v % 50 == 0 ? n / 2 : 2;
+            for (int i = 0; i < degree; ++i)
+            {
+                edges.push_back({v, pick(rng)});
+            }
+        }
+        return csr_graph<int>::from_edge_list(std::vector<int>(n, 0), edges);
+    }
+
+    std::vector<int> sorted_unique_neighbors(const csr_graph<int> &csr, int v)
+    {
+        auto neighbors = csr.neighbors(v);
+        std::vector<int> list(neighbors.begin(), neighbors.end());
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+        return list;
+    }
+}
+
+TEST(test_hybrid_graph, every_layout_matches_csr)
+{
+    std::mt19937 rng(13);
+    const int n = 700;
+    auto csr = mixed_density_graph(n, rng);
+
+    for (auto layout : {adjacency_layout::automatic, adjacency_layout::sparse, adjacency_layout::dense})
+    {
+        hybrid_graph<int> hybrid(csr, layout);
+        if (layout == adjacency_layout::automatic)
+        {
+            EXPECT_GT(hybrid.dense_vertex_count(), 0);
+            EXPECT_LT(hybrid.dense_vertex_count(), n);
+        }
+        for (int v = 0; v < n; ++v)
+        {
+            std::vector<int> expected = sorted_unique_neighbors(csr, v);
+            std::vector<int> actual;
+            hybrid.for_each_neighbor(v, [&](int u)
+                                     { actual.push_back(u); });
+            ASSERT_EQ(actual, expected);
+            ASSERT_EQ(hybrid.degree(v), static_cast<int>(expected.size()));
+        }
+
+        EXPECT_EQ(hybrid.find_component_labels(), csr.find_component_labels());
+        EXPECT_EQ(hybrid.find_connected_components().get_length(), csr.find_connected_components().get_length());
+
+        bfs_workspace workspace;
+        breadth_first_search(csr, 5, workspace, false);
+        auto distances = hybrid.bfs_distances(5);
+        for (int v = 0; v < n; ++v)
+        {
+            ASSERT_EQ(distances[v], workspace.reached(v) ? workspace.distance(v) : -1);
+        }
+    }
+}
+
+TEST(test_hybrid_graph, set_operations_agree_across_layouts)
+{
+    std::mt19937 rng(19);
+    const int n = 300;
+    auto csr = mixed_density_graph(n, rng);
+    hybrid_graph<int> hybrid(csr);
+
+    for (int u = 0; u < 40; ++u)
+    {
+        for (int v = 0; v < 40; ++v)
+        {
+            std::vector<int> a = sorted_unique_neighbors(csr, u);
+            std::vector<int> b = sorted_unique_neighbors(csr, v);
+            std::vector<int> common;
+            std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(common));
+            ASSERT_EQ(hybrid.common_neighbor_count(u, v), static_cast<int>(common.size()));
+            ASSERT_EQ(hybrid.has_edge(u, v), std::binary_search(a.begin(), a.end(), v));
+
+            dynamic_bitset set(n);
+            hybrid.unite_neighbors(u, set);
+            hybrid.intersect_neighbors(v, set);
+            for (int w = 0; w < n; ++w)
+            {
+                ASSERT_EQ(set.test(w), std::binary_search(common.begin(), common.end(), w));
+            }
+        }
+    }
+
+    dynamic_bitset wrong_size(n + 1);
+    EXPECT_THROW(hybrid.unite_neighbors(0, wrong_size), std::invalid_argument);
+}
+
+TEST(test_hybrid_graph, dense_graph_uses_rows_and_same_api)
+{
+    auto hybrid = hybrid_graph<int>::from_edge_list({10, 20, 30, 40}, {{0, 1}, {0, 2}, {0, 3}, {1, 2}, {0, 1}});
+    // With four vertices a row is one word, smaller than any list of three.
+    EXPECT_TRUE(hybrid.is_dense(0));
+    EXPECT_EQ(hybrid.degree(0), 3);
+    EXPECT_EQ(hybrid.vertex_data(3), 40);
+    EXPECT_EQ(to_dot(hybrid), to_dot(csr_graph<int>::from_edge_list({10, 20, 30, 40},
+                                                                     {{0, 1}, {0, 2}, {0, 3}, {1, 2}})));
+    EXPECT_THROW(hybrid.degree(4), std::out_of_range);
+
+    hybrid_graph<int> empty;
+    EXPECT_EQ(empty.vertex_count(), 0);
+    EXPECT_TRUE(empty.find_component_labels().empty());
+}
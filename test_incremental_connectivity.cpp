@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <random>
+#include <thread>
+#include "csr_graph.hpp"
+#include "incremental_connectivity.hpp"
+
+TEST(test_incremental_connectivity, follows_edge_generator_updates)
+{
+    undirected_graph<int> graph;
+    for (int i = 0; i < 4; ++i)
+    {
+        graph.add_vertex(i);
+    }
+
+    incremental_connectivity<int> connectivity(graph);
+    EXPECT_FALSE(connectivity.connected(0, 1));
+
+    graph.set_edge_generator(0, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(1);
+        return neighbors; });
+    EXPECT_TRUE(connectivity.connected(0, 1));
+    EXPECT_FALSE(connectivity.connected(1, 2));
+
+    int v = graph.add_vertex(4);
+    graph.set_edge_generator(v, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(2);
+        return neighbors; });
+    EXPECT_TRUE(connectivity.connected(2, 4));
+    EXPECT_EQ(connectivity.component_of(2), connectivity.component_of(4));
+    EXPECT_NE(connectivity.component_of(0), connectivity.component_of(4));
+
+    EXPECT_THROW(connectivity.connected(0, 5), std::out_of_range);
+}
+
+TEST(test_incremental_connectivity, seeds_from_existing_edges)
+{
+    undirected_graph<int> graph;
+    for (int i = 0; i < 3; ++i)
+    {
+        graph.add_vertex(i);
+    }
+    graph.set_edge_generator(2, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(0);
+        return neighbors; });
+
+    incremental_connectivity<int> connectivity(graph);
+    EXPECT_TRUE(connectivity.connected(0, 2));
+    EXPECT_FALSE(connectivity.connected(0, 1));
+}
+
+TEST(test_incremental_connectivity, concurrent_stress_matches_dfs)
+{
+    const int n = 5000;
+    const int m = 4000;
+    const int writers = 4;
+    const int readers = 2;
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i < m; ++i)
+    {
+        edges.push_back({pick(rng), pick(rng)});
+    }
+
+    undirected_graph<int> graph;
+    for (int i = 0; i < n; ++i)
+    {
+        graph.add_vertex(i);
+    }
+    incremental_connectivity<int> connectivity(graph);
+
+    std::atomic<bool> done(false);
+    std::vector<std::thread> threads;
+    for (int w = 0; w < writers; ++w)
+    {
+        threads.emplace_back([&, w]()
+                             {
+            for (int i = w; i < m; i += writers)
+            {
+                connectivity.insert_edge(edges[i].first, edges[i].second);
+            } });
+    }
+
+    // Readers only check a monotone invariant: an inserted edge's endpoints
+    // stay connected forever.
+    std::atomic<int> violations(0);
+    for (int r = 0; r < readers; ++r)
+    {
+        threads.emplace_back([&, r]()
+                             {
+            std::mt19937 local(100 + r);
+            while (!done.load())
+            {
+                int a = pick(local);
+                int b = pick(local);
+                bool before = connectivity.connected(a, b);
+                if (before && !connectivity.connected(a, b))
+                {
+                    ++violations;
+                }
+                connectivity.component_of(a);
+            } });
+    }
+
+    for (int w = 0; w < writers; ++w)
+    {
+        threads[w].join();
+    }
+    done = true;
+    for (int t = writers; t < writers + readers; ++t)
+    {
+        threads[t].join();
+    }
+    EXPECT_EQ(violations.load(), 0);
+
+    auto expected = component_labels(csr_graph<int>::from_edge_list(std::vector<int>(n, 0), edges));
+    for (int i = 0; i < 20000; ++i)
+    {
+        int a = pick(rng);
+        int b = pick(rng);
+        ASSERT_EQ(connectivity.connected(a, b), expected[a] == expected[b]);
+    }
+    for (int v = 0; v < n; ++v)
+    {
+        int representative = connectivity.component_of(v);
+        ASSERT_EQ(expected[representative], expected[v]);
+    }
+}
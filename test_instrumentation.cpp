@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <vector>
+#include "csr_graph.hpp"
+#include "instrumentation.hpp"
+#include "undirected_graph.hpp"
+
+// These run in both builds: with GRAPH_INSTRUMENTATION the counters must
+// match the work done, without it they must stay at zero.
+
+namespace
+{
+    undirected_graph<int> make_path(int n)
+    {
+        undirected_graph<int> graph;
+        for (int v = 0; v < n; ++v)
+        {
+            graph.add_vertex(v);
+        }
+        for (int v = 0; v < n; ++v)
+        {
+            graph.set_edge_generator(v, [v, n]()
+                                     {
+                list_sequence<int> neighbors;
+                if (v > 0)
+                {
+                    neighbors.append_element(v - 1);
+                }
+                if (v + 1 < n)
+                {
+                    neighbors.append_element(v + 1);
+                }
+                return neighbors; });
+        }
+        return graph;
+    }
+}
+
+TEST(test_instrumentation, counts_generator_calls_edges_and_phases)
+{
+    auto graph = make_path(10);
+    instrumentation::reset();
+    auto components = graph.find_connected_components();
+    ASSERT_EQ(components.get_length(), 1);
+
+    auto stats = instrumentation::snapshot();
+    if constexpr (instrumentation::enabled)
+    {
+        EXPECT_EQ(stats.get(instrumentation::counter::generator_calls), 10);
+        EXPECT_EQ(stats.get(instrumentation::counter::edges_scanned), 18);
+        EXPECT_EQ(stats.get(instrumentation::counter::vertices_visited), 10);
+        EXPECT_GT(stats.get(instrumentation::counter::allocations), 0);
+        ASSERT_NE(stats.phase("find_connected_components"), nullptr);
+        EXPECT_EQ(stats.phase("find_connected_components")->calls, 1);
+        EXPECT_EQ(stats.phase("connected_components")->calls, 1);
+    }
+    else
+    {
+        for (long long value : stats.counters)
+        {
+            EXPECT_EQ(value, 0);
+        }
+        EXPECT_TRUE(stats.phases.empty());
+    }
+
+    instrumentation::reset();
+    EXPECT_EQ(instrumentation::snapshot().get(instrumentation::counter::edges_scanned), 0);
+}
+
+TEST(test_instrumentation, counts_cache_hits_and_csr_scans)
+{
+    auto graph = make_path(6);
+    graph.set_cache_config({cache_policy::materialize, 0});
+    instrumentation::reset();
+    graph.find_component_labels();
+    graph.find_component_labels();
+    EXPECT_EQ(graph.get_cache_stats().hits, 6u);
+    EXPECT_EQ(graph.get_cache_stats().misses, 6u);
+    if constexpr (instrumentation::enabled)
+    {
+        auto stats = instrumentation::snapshot();
+        EXPECT_EQ(stats.get(instrumentation::counter::cache_hits), 6);
+        EXPECT_EQ(stats.get(instrumentation::counter::cache_misses), 6);
+        EXPECT_EQ(stats.get(instrumentation::counter::generator_calls), 6);
+    }
+
+    csr_graph<int> csr(graph);
+    instrumentation::reset();
+    csr.find_component_labels();
+
+    auto stats = instrumentation::snapshot();
+    if constexpr (instrumentation::enabled)
+    {
+        EXPECT_EQ(stats.get(instrumentation::counter::edges_scanned), 10);
+        EXPECT_EQ(stats.phase("component_labels")->calls, 1);
+    }
+}
+
+TEST(test_instrumentation, counting_resource_and_json)
+{
+    instrumentation::counting_resource counted(std::pmr::new_delete_resource());
+    {
+        std::pmr::vector<int> values(&counted);
+        values.reserve(100);
+    }
+    EXPECT_EQ(counted.allocations(), 1);
+    EXPECT_EQ(counted.bytes(), static_cast<long long>(100 * sizeof(int)));
+
+    instrumentation::stats stats;
+    stats.counters[static_cast<int>(instrumentation::counter::cache_hits)] = 7;
+    stats.phases.push_back({"bfs", 2, 1.5, {}});
+    std::string json = stats.to_json();
+    EXPECT_NE(json.find("\"cache_hits\": 7"), std::string::npos);
+    EXPECT_NE(json.find("\"name\": \"bfs\", \"calls\": 2, \"milliseconds\": 1.5"), std::string::npos);
+    EXPECT_NE(json.find("\"cycles\": null"), std::string::npos);
+}
+
+TEST(test_instrumentation, perf_counters_report_or_degrade)
+{
+    instrumentation::perf_counter_group group;
+    group.start();
+    volatile long long sum = 0;
+    for (int i = 0; i < 100000; ++i)
+    {
+        sum = sum + i;
+    }
+    group.stop();
+    auto counters = group.read();
+    if (group.available())
+    {
+        EXPECT_GT(counters.cycles, 0);
+    }
+    else
+    {
+        EXPECT_FALSE(counters.available());
+    }
+
+    instrumentation::hardware_counters total;
+    total += {100, -1, 3, -1};
+    total += {50, -1, -1, -1};
+    EXPECT_EQ(total.cycles, 150);
+    EXPECT_EQ(total.instructions, -1);
+    EXPECT_EQ(total.cache_misses, 3);
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <mutex>
+#include <random>
+#include "multi_source_bfs.hpp"
+#include "shortest_paths.hpp"
+#include "graph_builder.hpp"
+
+namespace
+{
+    csr_graph<int> random_graph(int n, int m, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> pick(0, n - 1);
+        std::vector<std::pair<int, int>> edges;
+        for (int i = 0; i < m; ++i)
+        {
+            edges.push_back({pick(rng), pick(rng)});
+        }
+        return build_csr_graph(std::vector<int>(n, 0), edges);
+    }
+
+    template <typename graph>
+    void expect_matches_single_source(const graph &gr, const std::vector<int> &sources, const distance_matrix &matrix)
+    {
+        ASSERT_EQ(matrix.source_count, static_cast<int>(sources.size()));
+        bfs_workspace workspace;
+        for (int i = 0; i < static_cast<int>(sources.size()); ++i)
+        {
+            breadth_first_search(gr, sources[i], workspace);
+            for (int v = 0; v < gr.vertex_count(); ++v)
+            {
+                int expected = workspace.reached(v) ? workspace.distance(v) : distance_matrix::unreachable;
+                ASSERT_EQ(matrix.at(i, v), expected) << "source " << i << " vertex " << v;
+            }
+        }
+    }
+}
+
+TEST(test_multi_source_bfs, matches_single_source_bfs_across_batches)
+{
+    auto csr = random_graph(2000, 2600, 7);
+    std::vector<int> sources;
+    for (int i = 0; i < 150; ++i)
+    {
+        sources.push_back((i * 37) % 2000);
+    }
+    sources.push_back(sources.front());
+
+    expect_matches_single_source(csr, sources, multi_source_distances(csr, sources));
+    expect_matches_single_source(csr, sources, multi_source_distances<2>(csr, sources, 4));
+    expect_matches_single_source(csr, sources, multi_source_distances<4>(csr, sources, 0));
+}
+
+TEST(test_multi_source_bfs, callback_sees_each_reached_pair_once)
+{
+    auto graph = build_undirected_graph(std::vector<int>(6, 0),
+                                        std::vector<std::pair<int, int>>{{0, 1}, {1, 2}, {3, 4}});
+    std::vector<int> sources = {0, 3, 5};
+
+    std::mutex mutex;
+    std::vector<std::tuple<int, int, int>> seen;
+    multi_source_bfs(graph, std::span<const int>(sources), [&](int source_index, int v, int distance)
+                     {
+        std::lock_guard<std::mutex> lock(mutex);
+        seen.push_back({source_index, v, distance}); }, 2);
+
+    std::sort(seen.begin(), seen.end());
+    EXPECT_EQ(seen, (std::vector<std::tuple<int, int, int>>{
+                        {0, 0, 0}, {0, 1, 1}, {0, 2, 2}, {1, 3, 0}, {1, 4, 1}, {2, 5, 0}}));
+
+    auto matrix = multi_source_distances(graph, sources);
+    EXPECT_EQ(matrix.row(2)[5], 0);
+    EXPECT_EQ(matrix.row(2)[0], distance_matrix::unreachable);
+}
+
+TEST(test_multi_source_bfs, empty_and_invalid_sources)
+{
+    auto csr = random_graph(10, 10, 1);
+    auto matrix = multi_source_distances(csr, std::vector<int>{});
+    EXPECT_EQ(matrix.source_count, 0);
+    EXPECT_TRUE(matrix.distances.empty());
+    EXPECT_THROW(multi_source_distances(csr, std::vector<int>{10}), std::out_of_range);
+}
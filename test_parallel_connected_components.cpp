@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "csr_graph.hpp"
+#include "parallel_connected_components.hpp"
+
+namespace
+{
+    csr_graph<int> random_graph(int n, int m, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> pick(0, n - 1);
+        std::vector<std::pair<int, int>> edges;
+        for (int i = 0; i < m; ++i)
+        {
+            edges.push_back({pick(rng), pick(rng)});
+        }
+        return csr_graph<int>::from_edge_list(std::vector<int>(n, 0), edges);
+    }
+}
+
+TEST(test_parallel_connected_components, empty_graph)
+{
+    csr_graph<int> graph;
+    EXPECT_TRUE(parallel_component_labels(graph, 4).empty());
+}
+
+TEST(test_parallel_connected_components, labels_match_sequential)
+{
+    for (unsigned seed = 1; seed <= 5; ++seed)
+    {
+        auto graph = random_graph(20000, 12000, seed);
+        auto expected = component_labels(graph);
+
+        for (int threads : {1, 2, 4, 8})
+        {
+            EXPECT_EQ(parallel_component_labels(graph, threads), expected)
+                << "seed " << seed << ", threads " << threads;
+        }
+    }
+}
+
+TEST(test_parallel_connected_components, works_on_generator_graph)
+{
+    undirected_graph<int> graph;
+    const int n = 1000;
+    for (int i = 0; i < n; ++i)
+    {
+        graph.add_vertex(i);
+    }
+    for (int i = 0; i < n; ++i)
+    {
+        graph.set_edge_generator(i, [i]()
+                                 {
+            list_sequence<int> neighbors;
+            if (i % 10 != 0)
+            {
+                neighbors.append_element(i - 1);
+            }
+            if (i % 10 != 9)
+            {
+                neighbors.append_element(i + 1);
+            }
+            return neighbors; });
+    }
+
+    auto labels = parallel_component_labels(graph, 4);
+    EXPECT_EQ(labels, graph.find_component_labels());
+    EXPECT_EQ(labels[999], 99);
+
+    auto components = components_from_labels(labels);
+    EXPECT_EQ(components.get_length(), 100);
+    EXPECT_EQ(components[7].get_length(), 10);
+}
+
+TEST(test_parallel_connected_components, parallel_for_rethrows_worker_exception)
+{
+    EXPECT_THROW(parallel_for(0, 10000, 4, [](int i)
+                              {
+        if (i == 5000)
+        {
+            throw std::runtime_error("boom");
+        } }, 16),
+                 std::runtime_error);
+}
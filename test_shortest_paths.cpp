@@ -0,0 +1,256 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "shortest_paths.hpp"
+#include "csr_graph.hpp"
+#include "graph_builder.hpp"
+
+namespace
+{
+    std::vector<std::pair<int, int>> random_edges(int n, int m, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<int> pick(0, n - 1);
+        std::vector<std::pair<int, int>> edges;
+        for (int i = 0; i < m; ++i)
+        {
+            edges.push_back({pick(rng), pick(rng)});
+        }
+        return edges;
+    }
+
+    // Bellman-Ford style relaxation until nothing changes.
+    template <typename graph>
+    std::vector<long long> reference_distances(const graph &gr, int source)
+    {
+        const long long infinity = std::numeric_limits<long long>::max();
+        std::vector<long long> distance(gr.vertex_count(), infinity);
+        distance[source] = 0;
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+            for (int v = 0; v < gr.vertex_count(); ++v)
+            {
+                if (distance[v] == infinity)
+                {
+                    continue;
+                }
+                for (auto [u, weight] : gr.edges(v))
+                {
+                    long long length = 1;
+                    if constexpr (is_weighted_v<typename graph::edge_type>)
+                    {
+                        length = weight;
+                    }
+                    if (distance[v] + length < distance[u])
+                    {
+                        distance[u] = distance[v] + length;
+                        changed = true;
+                    }
+                }
+            }
+        }
+        return distance;
+    }
+
+    template <typename graph, typename t_distance>
+    void expect_valid_path(const graph &gr, const std::vector<int> &path, int source, int target, t_distance length)
+    {
+        ASSERT_FALSE(path.empty());
+        EXPECT_EQ(path.front(), source);
+        EXPECT_EQ(path.back(), target);
+        t_distance total = 0;
+        for (std::size_t i = 0; i + 1 < path.size(); ++i)
+        {
+            t_distance best = search_labels<t_distance>::infinity;
+            gr.for_each_edge(path[i], [&](int u, const auto &weight)
+                             {
+                if (u == path[i + 1])
+                {
+                    best = std::min(best, edge_length<t_distance>(weight));
+                } });
+            ASSERT_NE(best, search_labels<t_distance>::infinity);
+            total += best;
+        }
+        EXPECT_EQ(total, length);
+    }
+}
+
+TEST(test_shortest_paths, heaps_pop_in_key_order)
+{
+    dary_heap<int> heap;
+    heap.reserve_ids(6);
+    heap.push_or_decrease(0, 50);
+    heap.push_or_decrease(1, 20);
+    heap.push_or_decrease(2, 40);
+    heap.push_or_decrease(0, 10);
+    heap.push_or_decrease(2, 45);
+    EXPECT_EQ(heap.size(), 3u);
+    EXPECT_EQ(heap.pop(), (std::pair<int, int>{10, 0}));
+    EXPECT_EQ(heap.pop(), (std::pair<int, int>{20, 1}));
+    EXPECT_EQ(heap.pop(), (std::pair<int, int>{40, 2}));
+    EXPECT_TRUE(heap.empty());
+
+    radix_heap radix;
+    radix.push(7, 1);
+    radix.push(3, 2);
+    radix.push(1000, 3);
+    EXPECT_EQ(radix.pop().second, 2);
+    radix.push(5, 4);
+    EXPECT_EQ(radix.pop().second, 4);
+    EXPECT_EQ(radix.pop().second, 1);
+    EXPECT_EQ(radix.pop().second, 3);
+    EXPECT_TRUE(radix.empty());
+}
+
+TEST(test_shortest_paths, bfs_matches_reference_in_both_modes)
+{
+    const int n = 3000;
+    auto csr = build_csr_graph(std::vector<int>(n, 0), random_edges(n, 9000, 3));
+    auto expected = reference_distances(csr, 17);
+
+    bfs_workspace workspace;
+    for (bool direction_optimizing : {false, true})
+    {
+        breadth_first_search(csr, 17, workspace, direction_optimizing);
+        for (int v = 0; v < n; ++v)
+        {
+            if (expected[v] == std::numeric_limits<long long>::max())
+            {
+                EXPECT_FALSE(workspace.reached(v));
+            }
+            else
+            {
+                ASSERT_EQ(workspace.distance(v), expected[v]) << v;
+                if (v != 17)
+                {
+                    EXPECT_EQ(workspace.distance(workspace.parent(v)), expected[v] - 1);
+                }
+            }
+        }
+    }
+}
+
+TEST(test_shortest_paths, bfs_on_generator_graph)
+{
+    auto csr = csr_graph<int>::from_edge_list({0, 1, 2, 3, 4}, {{0, 1}, {1, 2}, {2, 3}, {0, 3}});
+    auto graph = build_undirected_graph(std::vector<int>{0, 1, 2, 3, 4},
+                                        std::vector<std::pair<int, int>>{{0, 1}, {1, 2}, {2, 3}, {0, 3}});
+
+    bfs_workspace workspace;
+    breadth_first_search(graph, 0, workspace);
+    EXPECT_EQ(workspace.distance(2), 2);
+    EXPECT_EQ(workspace.distance(3), 1);
+    EXPECT_FALSE(workspace.reached(4));
+    EXPECT_EQ(workspace.path_to(2).size(), 3u);
+    EXPECT_TRUE(workspace.path_to(4).empty());
+    EXPECT_THROW(breadth_first_search(graph, 5, workspace), std::out_of_range);
+}
+
+TEST(test_shortest_paths, dijkstra_heaps_agree_with_reference)
+{
+    const int n = 2000;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> weight(1, 100);
+    std::vector<std::tuple<int, int, int>> edges;
+    for (auto [u, v] : random_edges(n, 8000, 5))
+    {
+        edges.push_back({u, v, weight(rng)});
+    }
+    auto csr = csr_graph<int, int>::from_weighted_edge_list(std::vector<int>(n, 0), edges);
+    auto expected = reference_distances(csr, 0);
+
+    dijkstra_workspace<long long> workspace;
+    for (dijkstra_heap heap : {dijkstra_heap::dary, dijkstra_heap::radix})
+    {
+        dijkstra(csr, 0, workspace, -1, heap);
+        for (int v = 0; v < n; ++v)
+        {
+            ASSERT_EQ(workspace.distance(v), expected[v]) << v;
+        }
+    }
+
+    dijkstra_workspace<double> real_workspace;
+    dijkstra(csr, 0, real_workspace);
+    EXPECT_DOUBLE_EQ(real_workspace.distance(n - 1), static_cast<double>(expected[n - 1]));
+    EXPECT_THROW(dijkstra(csr, 0, real_workspace, -1, dijkstra_heap::radix), std::invalid_argument);
+
+    dijkstra(csr, 0, workspace, 42);
+    expect_valid_path(csr, workspace.path_to(42), 0, 42, workspace.distance(42));
+}
+
+TEST(test_shortest_paths, bidirectional_matches_single_source)
+{
+    const int n = 2000;
+    auto unweighted = build_csr_graph(std::vector<int>(n, 0), random_edges(n, 3000, 8));
+    std::mt19937 rng(13);
+    std::uniform_int_distribution<int> weight(0, 50);
+    std::vector<std::tuple<int, int, long long>> edges;
+    for (auto [u, v] : random_edges(n, 5000, 9))
+    {
+        edges.push_back({u, v, weight(rng)});
+    }
+    auto weighted = csr_graph<int, long long>::from_weighted_edge_list(std::vector<int>(n, 0), edges);
+
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    bidirectional_workspace<long long> pair_workspace;
+    dijkstra_workspace<long long> workspace;
+    for (int query = 0; query < 50; ++query)
+    {
+        int s = pick(rng);
+        int t = pick(rng);
+
+        dijkstra(unweighted, s, workspace);
+        long long hops = bidirectional_search(unweighted, s, t, pair_workspace);
+        ASSERT_EQ(hops, workspace.distance(t));
+        if (hops != search_labels<long long>::infinity)
+        {
+            expect_valid_path(unweighted, pair_workspace.path(), s, t, hops);
+        }
+
+        dijkstra(weighted, s, workspace);
+        long long length = bidirectional_search(weighted, s, t, pair_workspace);
+        ASSERT_EQ(length, workspace.distance(t));
+        if (length != search_labels<long long>::infinity)
+        {
+            expect_valid_path(weighted, pair_workspace.path(), s, t, length);
+        }
+        else
+        {
+            EXPECT_TRUE(pair_workspace.path().empty());
+        }
+    }
+}
+
+TEST(test_shortest_paths, repeated_queries_reuse_workspace_storage)
+{
+    const int n = 5000;
+    auto csr = build_csr_graph(std::vector<int>(n, 0), random_edges(n, 20000, 21));
+
+    bidirectional_workspace<int> workspace;
+    bidirectional_search(csr, 0, n - 1, workspace);
+    bidirectional_search(csr, 1, n - 2, workspace);
+    const int *distances = workspace.forward.distances.data();
+    std::size_t touched_capacity = workspace.forward.touched.capacity();
+    std::size_t next_capacity = workspace.next.capacity();
+
+    std::mt19937 rng(4);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    for (int query = 0; query < 200; ++query)
+    {
+        bidirectional_search(csr, pick(rng), pick(rng), workspace);
+        touched_capacity = std::max(touched_capacity, workspace.forward.touched.capacity());
+        next_capacity = std::max(next_capacity, workspace.next.capacity());
+    }
+    EXPECT_EQ(workspace.forward.distances.data(), distances);
+    EXPECT_LE(touched_capacity, static_cast<std::size_t>(n));
+    EXPECT_LE(next_capacity, static_cast<std::size_t>(n));
+    EXPECT_EQ(bidirectional_search(csr, 3, 3, workspace), 0);
+}
+
+TEST(test_shortest_paths, negative_weight_rejected)
+{
+    auto csr = csr_graph<int, int>::from_weighted_edge_list({0, 1}, {{0, 1, -1}});
+    dijkstra_workspace<int> workspace;
+    EXPECT_THROW(dijkstra(csr, 0, workspace), std::invalid_argument);
+}
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <tuple>
+#include "connected_components.hpp"
+#include "csr_graph.hpp"
+#include "graph_builder.hpp"
+#include "graph_generators.hpp"
+#include "spanning_forest.hpp"
+
+namespace
+{
+    // O(n^2) Prim from every unvisited vertex; minimum over parallel edges.
+    long long prim_total(int n, const std::vector<std::tuple<int, int, int>> &edges)
+    {
+        const long long none = std::numeric_limits<long long>::max();
+        std::vector<std::vector<long long>> weight(n, std::vector<long long>(n, none));
+        for (auto [u, v, w] : edges)
+        {
+            if (u != v)
+            {
+                weight[u][v] = weight[v][u] = std::min<long long>(weight[u][v], w);
+            }
+        }
+        std::vector<bool> done(n, false);
+        std::vector<long long> key(n, none);
+        long long total = 0;
+        for (int round = 0; round < n; ++round)
+        {
+            int next = -1;
+            for (int v = 0; v < n; ++v)
+            {
+                if (!done[v] && (next < 0 || key[v] < key[next]))
+                {
+                    next = v;
+                }
+            }
+            done[next] = true;
+            if (key[next] != none)
+            {
+                total += key[next];
+            }
+            for (int v = 0; v < n; ++v)
+            {
+                if (!done[v] && weight[next][v] < key[v])
+                {
+                    key[v] = weight[next][v];
+                }
+            }
+        }
+        return total;
+    }
+}
+
+TEST(test_spanning_forest, small_forest_has_per_component_weights)
+{
+    // Component {0, 1, 2, 3} with a cycle, isolated 4, and {5, 6}.
+    auto csr = csr_graph<int, int>::from_weighted_edge_list(
+        std::vector<int>(7, 0),
+        {{0, 1, 4}, {1, 2, 1}, {2, 3, 2}, {3, 0, 3}, {0, 2, 5}, {5, 6, 7}, {6, 6, 1}});
+
+    for (spanning_forest_method method : {spanning_forest_method::kruskal, spanning_forest_method::boruvka})
+    {
+        spanning_forest<int> forest = minimum_spanning_forest(csr, method, 2);
+        ASSERT_EQ(forest.edges.size(), 4u);
+        EXPECT_EQ(forest.edges[0].u, 1);
+        EXPECT_EQ(forest.edges[0].v, 2);
+        EXPECT_EQ(forest.edges[3].weight, 7);
+        EXPECT_EQ(forest.component_of, (std::vector<int>{0, 0, 0, 0, 1, 2, 2}));
+        EXPECT_EQ(forest.component_weight, (std::vector<int>{6, 0, 7}));
+        EXPECT_EQ(forest.total_weight, 13);
+        EXPECT_EQ(forest.component_count(), 3);
+    }
+
+    auto empty = csr_graph<int, int>::from_weighted_edge_list({}, {});
+    EXPECT_EQ(boruvka_spanning_forest(empty).component_count(), 0);
+    EXPECT_EQ(kruskal_spanning_forest(empty).component_count(), 0);
+}
+
+TEST(test_spanning_forest, kruskal_and_boruvka_agree_with_prim)
+{
+    std::mt19937 rng(61);
+    for (auto [n, p] : {std::pair{150, 0.01}, std::pair{150, 0.05}, std::pair{300, 0.2}})
+    {
+        // Few distinct weights, so ties and parallel edges are common.
+        std::uniform_int_distribution<int> weight(1, 5);
+        std::vector<std::tuple<int, int, int>> edges;
+        for (auto [u, v] : erdos_renyi_edges(n, p, rng))
+        {
+            edges.push_back({u, v, weight(rng)});
+            if (weight(rng) == 1)
+            {
+                edges.push_back({v, u, weight(rng)});
+            }
+        }
+        auto csr = csr_graph<int, int>::from_weighted_edge_list(std::vector<int>(n, 0), edges);
+        std::vector<int> labels = component_labels(csr);
+        int components = *std::max_element(labels.begin(), labels.end()) + 1;
+
+        spanning_forest<int> expected = kruskal_spanning_forest(csr);
+        EXPECT_EQ(expected.total_weight, prim_total(n, edges));
+        EXPECT_EQ(expected.component_of, labels);
+        EXPECT_EQ(static_cast<int>(expected.edges.size()), n - components);
+
+        for (int threads : {1, 4})
+        {
+            spanning_forest<int> kruskal = kruskal_spanning_forest(csr, threads);
+            spanning_forest<int> boruvka = boruvka_spanning_forest(csr, threads);
+            for (const spanning_forest<int> *forest : {&kruskal, &boruvka})
+            {
+                ASSERT_EQ(forest->edges.size(), expected.edges.size());
+                for (std::size_t i = 0; i < expected.edges.size(); ++i)
+                {
+                    EXPECT_EQ(forest->edges[i].u, expected.edges[i].u);
+                    EXPECT_EQ(forest->edges[i].v, expected.edges[i].v);
+                    EXPECT_EQ(forest->edges[i].weight, expected.edges[i].weight);
+                }
+                EXPECT_EQ(forest->component_of, labels);
+                EXPECT_EQ(forest->component_weight, expected.component_weight);
+            }
+        }
+    }
+}
+
+TEST(test_spanning_forest, unweighted_graphs_count_edges)
+{
+    auto grid = build_csr_graph(std::vector<int>(20 * 30, 0), grid_edges(20, 30));
+    spanning_forest<int> forest = boruvka_spanning_forest(grid, 3);
+    EXPECT_EQ(forest.total_weight, 20 * 30 - 1);
+    EXPECT_EQ(forest.component_count(), 1);
+
+    auto path = build_undirected_graph(std::vector<int>(50, 0), path_edges(50));
+    spanning_forest<int> tree = kruskal_spanning_forest(path, 2);
+    ASSERT_EQ(tree.edges.size(), 49u);
+    for (int i = 0; i < 49; ++i)
+    {
+        EXPECT_EQ(tree.edges[i].u, i);
+        EXPECT_EQ(tree.edges[i].v, i + 1);
+    }
+}
+
+TEST(test_spanning_forest, parallel_sort_matches_std_sort)
+{
+    std::mt19937 rng(67);
+    std::uniform_int_distribution<int> value(0, 1000);
+    for (int size : {0, 1, 1000, 100000, 250001})
+    {
+        std::vector<int> values(size);
+        for (int &x : values)
+        {
+            x = value(rng);
+        }
+        std::vector<int> expected = values;
+        std::sort(expected.begin(), expected.end(), std::greater<int>());
+        parallel_sort(values.begin(), values.end(), 4, std::greater<int>());
+        EXPECT_EQ(values, expected);
+    }
+
+    disjoint_set sets(5);
+    EXPECT_TRUE(sets.unite(0, 1));
+    EXPECT_TRUE(sets.unite(3, 1));
+    EXPECT_FALSE(sets.unite(0, 3));
+    EXPECT_TRUE(sets.same_set(0, 3));
+    EXPECT_FALSE(sets.same_set(0, 4));
+    EXPECT_EQ(sets.set_size(3), 3);
+    EXPECT_THROW(sets.find(5), std::out_of_range);
+}
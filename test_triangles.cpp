@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <set>
+#include "csr_graph.hpp"
+#include "graph_builder.hpp"
+#include "triangles.hpp"
+
+TEST(test_triangles, intersection_matches_std_on_balanced_and_skewed_inputs)
+{
+    std::mt19937 rng(23);
+    for (int trial = 0; trial < 200; ++trial)
+    {
+        auto make = [&](int size, int range)
+        {
+            std::uniform_int_distribution<int> pick(0, range);
+            std::set<int> values;
+            while (static_cast<int>(values.size()) < size)
+            {
+                values.insert(pick(rng));
+            }
+            return std::vector<int>(values.begin(), values.end());
+        };
+        // Sizes up to 1:100 cover both the block merge and galloping.
+        std::vector<int> a = make(1 + trial % 37, 400);
+        std::vector<int> b = make(1 + (trial * 7) % 300, 400);
+
+        std::vector<int> expected;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+        std::vector<int> actual;
+        intersect_sorted(a, b, [&](int x)
+                         { actual.push_back(x); });
+        ASSERT_EQ(actual, expected);
+    }
+}
+
+TEST(test_triangles, complete_graph_and_multigraph_edges)
+{
+    // K4 plus a pendant vertex, with a doubled edge and a self loop.
+    auto csr = csr_graph<int>::from_edge_list(std::vector<int>(5, 0),
+                                              {{0, 1}, {0, 2}, {0, 3}, {1, 2}, {1, 3}, {2, 3}, {3, 4}, {0, 1}, {2, 2}});
+    auto counts = count_triangles(csr);
+    EXPECT_EQ(counts.total, 4);
+    EXPECT_EQ(counts.per_vertex, (std::vector<long long>{3, 3, 3, 3, 0}));
+
+    auto clustering = compute_clustering(csr);
+    EXPECT_DOUBLE_EQ(clustering.local[0], 1.0);
+    EXPECT_DOUBLE_EQ(clustering.local[3], 0.5);
+    EXPECT_DOUBLE_EQ(clustering.local[4], 0.0);
+    // 12 closed triples out of 3 + 3 + 3 + 6 + 0 = 15 connected ones.
+    EXPECT_DOUBLE_EQ(clustering.global, 12.0 / 15.0);
+    EXPECT_DOUBLE_EQ(clustering.average, 3.5 / 5.0);
+}
+
+TEST(test_triangles, random_graphs_match_brute_force_serial_and_parallel)
+{
+    std::mt19937 rng(29);
+    const int n = 120;
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    // The denser graph has out-lists long enough for the probing path.
+    for (double p : {0.2, 0.7})
+    {
+        std::vector<std::pair<int, int>> edges;
+        std::vector<std::vector<char>> adjacent(n, std::vector<char>(n, 0));
+        for (int u = 0; u < n; ++u)
+        {
+            for (int v = u + 1; v < n; ++v)
+            {
+                if (coin(rng) < p)
+                {
+                    edges.push_back({u, v});
+                    adjacent[u][v] = adjacent[v][u] = 1;
+                }
+            }
+        }
+
+        std::vector<long long> expected(n, 0);
+        long long total = 0;
+        for (int a = 0; a < n; ++a)
+        {
+            for (int b = a + 1; b < n; ++b)
+            {
+                for (int c = b + 1; c < n; ++c)
+                {
+                    if (adjacent[a][b] && adjacent[b][c] && adjacent[a][c])
+                    {
+                        ++total;
+                        ++expected[a];
+                        ++expected[b];
+                        ++expected[c];
+                    }
+                }
+            }
+        }
+
+        auto graph = build_undirected_graph(std::vector<int>(n, 0), edges, {true, false, false, 1});
+        for (int threads : {1, 4})
+        {
+            auto counts = count_triangles(graph, threads);
+            EXPECT_EQ(counts.total, total);
+            EXPECT_EQ(counts.per_vertex, expected);
+        }
+    }
+}
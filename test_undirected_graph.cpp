@@ -432,4 +432,145 @@ TEST(test_undirected_graph, algorithm_does_not_modify_graph)
     auto neighbors_0 = graph.neighbors(0);
     EXPECT_EQ(neighbors_0.get_length(), initial_neighbors_0.get_length());
     EXPECT_EQ(neighbors_0.get(0), initial_neighbors_0.get(0));
-}
\ No newline at end of file
+}
+
+TEST(test_undirected_graph, for_each_neighbor_streams_generator_output)
+{
+    undirected_graph<int> graph;
+
+    graph.add_vertex(100);
+    graph.add_vertex(200);
+    graph.add_vertex(300);
+
+    graph.set_edge_generator(0, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(2);
+        neighbors.append_element(1);
+        return neighbors; });
+
+    list_sequence<int> visited;
+    graph.for_each_neighbor(0, [&](int u)
+                            { visited.append_element(u); });
+
+    EXPECT_EQ(visited.get_length(), 2);
+    EXPECT_EQ(visited.get(0), 2);
+    EXPECT_EQ(visited.get(1), 1);
+
+    int calls = 0;
+    graph.for_each_neighbor(1, [&](int)
+                            { ++calls; });
+    EXPECT_EQ(calls, 0);
+
+    EXPECT_THROW(graph.for_each_neighbor(3, [](int) {}), std::out_of_range);
+}
+
+TEST(test_undirected_graph, out_of_range_generator_output_throws)
+{
+    undirected_graph<int> graph;
+    graph.add_vertex(0);
+    graph.add_vertex(1);
+    graph.set_edge_generator(0, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(1);
+        neighbors.append_element(100000);
+        return neighbors; });
+    graph.set_edge_generator(1, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(-1);
+        return neighbors; });
+
+    EXPECT_THROW(graph.for_each_neighbor(0, [](int) {}), std::out_of_range);
+    EXPECT_THROW(graph.for_each_neighbor(1, [](int) {}), std::out_of_range);
+    EXPECT_THROW(graph.find_connected_components(), std::out_of_range);
+    EXPECT_THROW(component_labels(graph), std::out_of_range);
+
+    graph.set_cache_config({cache_policy::materialize, 0});
+    EXPECT_THROW(graph.for_each_neighbor(0, [](int) {}), std::out_of_range);
+    EXPECT_THROW(graph.find_connected_components(), std::out_of_range);
+}
+
+TEST(test_undirected_graph, component_labels_follow_component_order)
+{
+    undirected_graph<int> graph;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        graph.add_vertex(i * 100);
+    }
+
+    graph.set_edge_generator(0, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(3);
+        return neighbors; });
+
+    graph.set_edge_generator(3, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(0);
+        return neighbors; });
+
+    graph.set_edge_generator(2, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(4);
+        return neighbors; });
+
+    graph.set_edge_generator(4, []()
+                             {
+        list_sequence<int> neighbors;
+        neighbors.append_element(2);
+        return neighbors; });
+
+    auto labels = graph.find_component_labels();
+    ASSERT_EQ(labels.size(), 5u);
+    EXPECT_EQ(labels[0], 0);
+    EXPECT_EQ(labels[3], 0);
+    EXPECT_EQ(labels[1], 1);
+    EXPECT_EQ(labels[2], 2);
+    EXPECT_EQ(labels[4], 2);
+
+    auto components = graph.find_connected_components();
+    ASSERT_EQ(components.get_length(), 3);
+    for (int c = 0; c < components.get_length(); ++c)
+    {
+        for (int v : components[c])
+        {
+            EXPECT_EQ(labels[v], c);
+        }
+    }
+}
+
+TEST(test_undirected_graph, long_path_does_not_overflow_stack)
+{
+    undirected_graph<int> graph;
+    const int n = 200000;
+
+    for (int i = 0; i < n; ++i)
+    {
+        graph.add_vertex(i);
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        graph.set_edge_generator(i, [i, n]()
+                                 {
+            list_sequence<int> neighbors;
+            if (i > 0)
+            {
+                neighbors.append_element(i - 1);
+            }
+            if (i + 1 < n)
+            {
+                neighbors.append_element(i + 1);
+            }
+            return neighbors; });
+    }
+
+    auto components = graph.find_connected_components();
+    EXPECT_EQ(components.get_length(), 1);
+    EXPECT_EQ(components[0].get_length(), n);
+}
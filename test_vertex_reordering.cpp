@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <set>
+#include "csr_graph.hpp"
+#include "shortest_paths.hpp"
+#include "vertex_reordering.hpp"
+
+namespace
+{
+    // Path 0 - 1 - ... - (n - 1) with shuffled labels.
+    std::vector<std::pair<int, int>> shuffled_path(int n, std::mt19937 &rng)
+    {
+        std::vector<int> label(n);
+        for (int v = 0; v < n; ++v)
+        {
+            label[v] = v;
+        }
+        std::shuffle(label.begin(), label.end(), rng);
+        std::vector<std::pair<int, int>> edges;
+        for (int v = 0; v + 1 < n; ++v)
+        {
+            edges.push_back({label[v], label[v + 1]});
+        }
+        return edges;
+    }
+
+    int bandwidth(const csr_graph<int> &csr)
+    {
+        int widest = 0;
+        for (int v = 0; v < csr.vertex_count(); ++v)
+        {
+            for (int u : csr.neighbors(v))
+            {
+                widest = std::max(widest, std::abs(u - v));
+            }
+        }
+        return widest;
+    }
+
+    std::multiset<std::pair<int, int>> arcs_in_original_ids(const reordered_graph<int> &reordered)
+    {
+        std::multiset<std::pair<int, int>> arcs;
+        for (int v = 0; v < reordered.graph.vertex_count(); ++v)
+        {
+            for (int u : reordered.graph.neighbors(v))
+            {
+                arcs.insert({reordered.original_id(v), reordered.original_id(u)});
+            }
+        }
+        return arcs;
+    }
+}
+
+TEST(test_vertex_reordering, every_method_relabels_the_same_graph)
+{
+    std::mt19937 rng(3);
+    const int n = 300;
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i < 700; ++i)
+    {
+        edges.push_back({pick(rng), pick(rng)});
+    }
+    std::vector<int> payloads(n);
+    for (int v = 0; v < n; ++v)
+    {
+        payloads[v] = 1000 + v;
+    }
+    auto csr = csr_graph<int>::from_edge_list(payloads, edges);
+
+    std::multiset<std::pair<int, int>> expected;
+    for (int v = 0; v < n; ++v)
+    {
+        for (int u : csr.neighbors(v))
+        {
+            expected.insert({v, u});
+        }
+    }
+
+    for (auto method : {vertex_order::reverse_cuthill_mckee, vertex_order::degree_descending, vertex_order::gorder})
+    {
+        auto reordered = reorder_vertices(csr, method);
+        std::vector<int> sorted = reordered.to_original;
+        std::sort(sorted.begin(), sorted.end());
+        for (int v = 0; v < n; ++v)
+        {
+            ASSERT_EQ(sorted[v], v);
+            EXPECT_EQ(reordered.reordered_id(reordered.original_id(v)), v);
+            EXPECT_EQ(reordered.graph.vertex_data(v), 1000 + reordered.original_id(v));
+            auto neighbors = reordered.graph.neighbors(v);
+            EXPECT_TRUE(std::is_sorted(neighbors.begin(), neighbors.end()));
+        }
+        EXPECT_EQ(arcs_in_original_ids(reordered), expected);
+    }
+}
+
+TEST(test_vertex_reordering, components_map_back_to_original_ids)
+{
+    auto csr = csr_graph<int>::from_edge_list(std::vector<int>(7, 0), {{0, 5}, {5, 3}, {1, 6}, {2, 2}});
+    auto reordered = reorder_vertices(csr, vertex_order::reverse_cuthill_mckee);
+
+    std::set<std::set<int>> components;
+    for (const auto &component : reordered.original_ids(reordered.graph.find_connected_components()))
+    {
+        components.insert(std::set<int>(component.begin(), component.end()));
+    }
+    EXPECT_EQ(components, (std::set<std::set<int>>{{0, 3, 5}, {1, 6}, {2}, {4}}));
+
+    auto labels = reordered.in_original_order(reordered.graph.find_component_labels());
+    EXPECT_EQ(labels[0], labels[3]);
+    EXPECT_EQ(labels[1], labels[6]);
+    EXPECT_NE(labels[0], labels[1]);
+}
+
+TEST(test_vertex_reordering, reverse_cuthill_mckee_narrows_a_shuffled_path)
+{
+    std::mt19937 rng(11);
+    const int n = 2000;
+    auto csr = csr_graph<int>::from_edge_list(std::vector<int>(n, 0), shuffled_path(n, rng));
+    auto reordered = reorder_vertices(csr, vertex_order::reverse_cuthill_mckee);
+    EXPECT_GT(bandwidth(csr), 100);
+    EXPECT_EQ(bandwidth(reordered.graph), 1);
+
+    bfs_workspace workspace;
+    breadth_first_search(reordered.graph, reordered.reordered_id(0), workspace);
+    int reached = 0;
+    for (int v = 0; v < n; ++v)
+    {
+        reached += workspace.reached(v) ? 1 : 0;
+    }
+    EXPECT_EQ(reached, n);
+}
+
+TEST(test_vertex_reordering, degree_descending_puts_hubs_first)
+{
+    auto csr = csr_graph<int>::from_edge_list(std::vector<int>(6, 0),
+                                              {{5, 0}, {5, 1}, {5, 2}, {5, 3}, {4, 0}, {4, 1}});
+    auto order = degree_descending_order(csr);
+    EXPECT_EQ(order, (std::vector<int>{5, 0, 1, 4, 2, 3}));
+}
+
+TEST(test_vertex_reordering, weights_follow_their_arcs)
+{
+    auto csr = csr_graph<int, int>::from_weighted_edge_list(std::vector<int>(4, 0),
+                                                            {{0, 1, 10}, {1, 2, 20}, {2, 3, 30}, {3, 0, 40}});
+    std::vector<int> order{2, 0, 3, 1};
+    auto reordered = reorder_vertices(csr, std::span<const int>(order));
+    for (int v = 0; v < 4; ++v)
+    {
+        reordered.graph.for_each_edge(v, [&](int u, int weight)
+                                      {
+            int a = std::min(reordered.original_id(v), reordered.original_id(u));
+            int b = std::max(reordered.original_id(v), reordered.original_id(u));
+            int expected = (a == 0 && b == 3) ? 40 : 10 * (a + 1);
+            EXPECT_EQ(weight, expected); });
+    }
+}
+
+TEST(test_vertex_reordering, rejects_orders_that_are_not_permutations)
+{
+    auto csr = csr_graph<int>::from_edge_list(std::vector<int>(3, 0), {{0, 1}});
+    std::vector<int> repeated{0, 0, 1};
+    std::vector<int> short_order{0, 1};
+    std::vector<int> out_of_range{0, 1, 3};
+    EXPECT_THROW(reorder_vertices(csr, std::span<const int>(repeated)), std::invalid_argument);
+    EXPECT_THROW(reorder_vertices(csr, std::span<const int>(short_order)), std::invalid_argument);
+    EXPECT_THROW(reorder_vertices(csr, std::span<const int>(out_of_range)), std::invalid_argument);
+    EXPECT_THROW(gorder_order(csr, 0), std::invalid_argument);
+}
@@ -4,32 +4,70 @@
 #include "lab3_2ndsem/headers/array_sequence.hpp"
 #include "pointers/uniq_ptr.hpp"
 #include "vertex.hpp"
+#include "edge.hpp"
+#include "graph_observer.hpp"
+#include "adjacency_cache.hpp"
 #include <functional>
+#include <memory_resource>
 #include <sstream>
 #include <variant>
+#include <vector>
 
 
 
+// Edge generators list neighbor ids, or edge<t_edge> entries carrying the
+// weight when t_edge is not std::monostate.
 template<typename t_vertex, typename t_edge = std::monostate>
 class undirected_graph
 {
+public:
+    using edge_type = t_edge;
+    using edge_generator = std::function<list_sequence<adjacency_entry<t_edge>>()>;
+
 private:
-    list_sequence<vertex<t_vertex>> vertices;
-    list_sequence<std::function<list_sequence<int>()>> adjacency;
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource();
+    array_sequence<vertex<t_vertex>> vertices;
+    array_sequence<edge_generator> adjacency;
+    observer_list observers;
+    mutable adjacency_cache cache{resource};
+
+    adjacency_cache::entry cached_neighbors(int vertex_id) const;
+    // Generators are user code, so every id they return is range-checked.
+    int checked_target(int target) const;
 
 public:
     undirected_graph() = default;
+    explicit undirected_graph(std::pmr::memory_resource *memory);
 
     int add_vertex(const t_vertex &value);
     int vertex_count() const;
 
-    void set_edge_generator(int vertex_id, std::function<list_sequence<int>()> edge_generator);
+    void set_edge_generator(int vertex_id, edge_generator generator);
 
     list_sequence<int> neighbors(int vertex_id) const;
 
+    template <typename visitor>
+    void for_each_neighbor(int vertex_id, visitor &&visit) const;
+
+    // visit(target, weight). Weighted graphs run the generator even when the
+    // cache is on, since the cache keeps neighbor ids only.
+    template <typename visitor>
+    void for_each_edge(int vertex_id, visitor &&visit) const;
+
     const t_vertex &vertex_data(int vertex_id) const;
 
     array_sequence<list_sequence<int>> find_connected_components();
+    std::vector<int> find_component_labels() const;
+
+    void set_cache_config(const cache_config &config);
+    cache_stats get_cache_stats() const;
+    void invalidate_cache(int vertex_id);
+    void clear_cache();
+
+    std::pmr::memory_resource *memory_resource() const;
+
+    void attach_observer(graph_observer *observer);
+    void detach_observer(graph_observer *observer);
 };
 
 #include "undirected_graph.tpp"
@@ -1,27 +1,39 @@
 #include "undirected_graph.hpp"
+#include "connected_components.hpp"
+#include "instrumentation.hpp"
 #include <stdexcept>
 #include <functional>
 
+// Cached adjacency is allocated from `memory`, which must outlive the graph.
+template <typename t_vertex, typename t_edge>
+undirected_graph<t_vertex, t_edge>::undirected_graph(std::pmr::memory_resource *memory)
+    : resource(memory), cache(memory)
+{
+}
+
 template <typename t_vertex, typename t_edge>
 int undirected_graph<t_vertex, t_edge>::add_vertex(const t_vertex &data)
 {
     int id = vertices.get_length();
     vertices.append_element(vertex<t_vertex>(id, data));
-    adjacency.append_element([]() -> list_sequence<int>
+    adjacency.append_element([]() -> list_sequence<adjacency_entry<t_edge>>
                              {
-                                 return list_sequence<int>{};
+                                 return list_sequence<adjacency_entry<t_edge>>{};
                              });
+    observers.notify_vertex_added(id);
     return id;
 }
 
 template <typename t_vertex, typename t_edge>
-void undirected_graph<t_vertex, t_edge>::set_edge_generator(int vertex_id, std::function<list_sequence<int>()> edge_generator)
+void undirected_graph<t_vertex, t_edge>::set_edge_generator(int vertex_id, edge_generator generator)
 {
     if (vertex_id < 0 || vertex_id >= adjacency.get_length())
     {
         throw std::out_of_range("Invalid vertex ID");
     }
-    adjacency.get(vertex_id) = std::move(edge_generator);
+    adjacency.get(vertex_id) = std::move(generator);
+    cache.invalidate(vertex_id);
+    observers.notify_edges_changed(vertex_id);
 }
 
 template <typename t_vertex, typename t_edge>
@@ -32,13 +44,137 @@ list_sequence<int> undirected_graph<t_vertex, t_edge>::neighbors(int vertex_id)
         throw std::out_of_range("Invalid vertex ID");
     }
 
-    auto generator = adjacency.get(vertex_id);
-    if (generator)
+    if (cache.enabled())
+    {
+        list_sequence<int> neighbors_list;
+        for (int u : *cached_neighbors(vertex_id))
+        {
+            neighbors_list.append_element(u);
+        }
+        return neighbors_list;
+    }
+
+    const auto &generator = adjacency.get(vertex_id);
+    if (!generator)
+    {
+        return list_sequence<int>{};
+    }
+    GRAPH_COUNT(generator_calls, 1);
+    if constexpr (is_weighted_v<t_edge>)
+    {
+        list_sequence<int> neighbors_list;
+        for (const auto &entry : generator())
+        {
+            neighbors_list.append_element(entry.target);
+        }
+        return neighbors_list;
+    }
+    else
     {
         list_sequence<int> neighbors_list = generator();
         return neighbors_list;
     }
-    return list_sequence<int>{};
+}
+
+template <typename t_vertex, typename t_edge>
+int undirected_graph<t_vertex, t_edge>::checked_target(int target) const
+{
+    if (target < 0 || target >= adjacency.get_length())
+    {
+        throw std::out_of_range("Invalid vertex ID");
+    }
+    return target;
+}
+
+template <typename t_vertex, typename t_edge>
+adjacency_cache::entry undirected_graph<t_vertex, t_edge>::cached_neighbors(int vertex_id) const
+{
+    auto entry = cache.lookup(vertex_id);
+    if (entry)
+    {
+        return entry;
+    }
+
+    std::pmr::vector<int> neighbors_vector(cache.memory_resource());
+    const auto &generator = adjacency.get(vertex_id);
+    if (generator)
+    {
+        // Sized up front: on an arena, growth would strand each old buffer.
+        GRAPH_COUNT(generator_calls, 1);
+        const auto neighbors_list = generator();
+        neighbors_vector.reserve(neighbors_list.get_length());
+        for (const auto &entry : neighbors_list)
+        {
+            neighbors_vector.push_back(checked_target(entry_target(entry)));
+        }
+    }
+    return cache.store(vertex_id, std::move(neighbors_vector));
+}
+
+template <typename t_vertex, typename t_edge>
+template <typename visitor>
+void undirected_graph<t_vertex, t_edge>::for_each_neighbor(int vertex_id, visitor &&visit) const
+{
+    if (vertex_id < 0 || vertex_id >= adjacency.get_length())
+    {
+        throw std::out_of_range("Invalid vertex ID");
+    }
+
+    if (cache.enabled())
+    {
+        auto cached = cached_neighbors(vertex_id);
+        GRAPH_COUNT(edges_scanned, static_cast<long long>(cached->size()));
+        for (int u : *cached)
+        {
+            visit(u);
+        }
+        return;
+    }
+
+    const auto &generator = adjacency.get(vertex_id);
+    if (!generator)
+    {
+        return;
+    }
+
+    GRAPH_COUNT(generator_calls, 1);
+    const auto neighbors_list = generator();
+    GRAPH_COUNT(edges_scanned, neighbors_list.get_length());
+    for (const auto &entry : neighbors_list)
+    {
+        visit(checked_target(entry_target(entry)));
+    }
+}
+
+template <typename t_vertex, typename t_edge>
+template <typename visitor>
+void undirected_graph<t_vertex, t_edge>::for_each_edge(int vertex_id, visitor &&visit) const
+{
+    if constexpr (is_weighted_v<t_edge>)
+    {
+        if (vertex_id < 0 || vertex_id >= adjacency.get_length())
+        {
+            throw std::out_of_range("Invalid vertex ID");
+        }
+        const auto &generator = adjacency.get(vertex_id);
+        if (!generator)
+        {
+            return;
+        }
+        GRAPH_COUNT(generator_calls, 1);
+        const auto neighbors_list = generator();
+        GRAPH_COUNT(edges_scanned, neighbors_list.get_length());
+        for (const auto &entry : neighbors_list)
+        {
+            visit(checked_target(entry.target), entry.data);
+        }
+    }
+    else
+    {
+        static constexpr std::monostate none;
+        for_each_neighbor(vertex_id, [&](int u)
+                          { visit(u, none); });
+    }
 }
 
 template <typename t_vertex, typename t_edge>
@@ -53,48 +189,70 @@ const t_vertex &undirected_graph<t_vertex, t_edge>::vertex_data(int id) const
     return vertices.get(id).data;
 }
 
+// Traversal scratch lives in a per-call arena freed in one step on return.
+// It sits on the default resource rather than the graph's, so repeated calls
+// cannot pile up inside a monotonic graph resource. Instrumented builds count
+// the arena's upstream allocations.
 template <typename t_vertex, typename t_edge>
 array_sequence<list_sequence<int>> undirected_graph<t_vertex, t_edge>::find_connected_components()
 {
-    int n = this->vertex_count();
+    GRAPH_PHASE("find_connected_components");
+    std::pmr::monotonic_buffer_resource arena(instrumentation::scratch_resource());
+    components_workspace workspace(&arena);
+    return connected_components(*this, workspace);
+}
 
-    array_sequence<bool> visited;
-    for (int i = 0; i < n; ++i)
-    {
-        visited.append_element(false);
-    }
+template <typename t_vertex, typename t_edge>
+std::vector<int> undirected_graph<t_vertex, t_edge>::find_component_labels() const
+{
+    std::pmr::monotonic_buffer_resource arena(instrumentation::scratch_resource());
+    components_workspace workspace(&arena);
+    return component_labels(*this, workspace);
+}
 
-    array_sequence<list_sequence<int>> components;
+template <typename t_vertex, typename t_edge>
+void undirected_graph<t_vertex, t_edge>::set_cache_config(const cache_config &config)
+{
+    cache.configure(config);
+}
 
-    std::function<void(int, list_sequence<int> &)> dfs =
-        [&](int v, list_sequence<int> &comp)
-    {
-        visited[v] = true;
+template <typename t_vertex, typename t_edge>
+cache_stats undirected_graph<t_vertex, t_edge>::get_cache_stats() const
+{
+    return cache.statistics();
+}
 
-        comp.append_element(v);
+// For generators whose output depends on state outside the graph.
+template <typename t_vertex, typename t_edge>
+void undirected_graph<t_vertex, t_edge>::invalidate_cache(int vertex_id)
+{
+    if (vertex_id < 0 || vertex_id >= adjacency.get_length())
+    {
+        throw std::out_of_range("Invalid vertex ID");
+    }
+    cache.invalidate(vertex_id);
+}
 
-        auto neighbors = this->neighbors(v);
+template <typename t_vertex, typename t_edge>
+void undirected_graph<t_vertex, t_edge>::clear_cache()
+{
+    cache.clear();
+}
 
-        int neighbor_count = neighbors.get_length();
-        for (int i = 0; i < neighbor_count; ++i)
-        {
-            int u = neighbors.get(i);
-            if (!visited.get(u))
-            {
-                dfs(u, comp);
-            }
-        }
-    };
+template <typename t_vertex, typename t_edge>
+std::pmr::memory_resource *undirected_graph<t_vertex, t_edge>::memory_resource() const
+{
+    return resource;
+}
 
-    for (int v = 0; v < n; ++v)
-    {
-        if (!visited.get(v))
-        {
-            list_sequence<int> component;              
-            dfs(v, component);                          
-            components.append_element(std::move(component)); 
-        }
-    }
+template <typename t_vertex, typename t_edge>
+void undirected_graph<t_vertex, t_edge>::attach_observer(graph_observer *observer)
+{
+    observers.attach(observer);
+}
 
-    return components;
-}
\ No newline at end of file
+template <typename t_vertex, typename t_edge>
+void undirected_graph<t_vertex, t_edge>::detach_observer(graph_observer *observer)
+{
+    observers.detach(observer);
+}
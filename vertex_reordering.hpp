@@ -0,0 +1,437 @@
+#pragma once
+
+#include "csr_graph.hpp"
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Relabelings that put vertices which are visited together next to each
+// other in memory. An order lists old ids by new id: order[new_id] = old_id.
+enum class vertex_order
+{
+    reverse_cuthill_mckee,
+    degree_descending,
+    gorder
+};
+
+template <typename graph>
+std::vector<int> vertex_degrees(const graph &gr)
+{
+    int n = gr.vertex_count();
+    std::vector<int> degrees(n, 0);
+    for (int v = 0; v < n; ++v)
+    {
+        gr.for_each_neighbor(v, [&](int)
+                             { ++degrees[v]; });
+    }
+    return degrees;
+}
+
+// Hubs first; ties keep the old order. Puts the most used adjacency lists
+// and payloads together at the front.
+template <typename graph>
+std::vector<int> degree_descending_order(const graph &gr)
+{
+    std::vector<int> degrees = vertex_degrees(gr);
+    std::vector<int> order(degrees.size());
+    for (int v = 0; v < static_cast<int>(order.size()); ++v)
+    {
+        order[v] = v;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b)
+                     { return degrees[a] > degrees[b]; });
+    return order;
+}
+
+// Reverse Cuthill-McKee: a BFS per component that visits neighbors by
+// ascending degree, reversed at the end. It keeps the labels of adjacent
+// vertices close, which narrows the band the adjacency matrix occupies.
+// Each component starts from a pseudo-peripheral vertex (George-Liu), so
+// the BFS levels are many and thin.
+template <typename graph>
+std::vector<int> reverse_cuthill_mckee_order(const graph &gr)
+{
+    int n = gr.vertex_count();
+    std::vector<int> degrees = vertex_degrees(gr);
+    std::vector<int> by_degree(n);
+    for (int v = 0; v < n; ++v)
+    {
+        by_degree[v] = v;
+    }
+    std::stable_sort(by_degree.begin(), by_degree.end(), [&](int a, int b)
+                     { return degrees[a] < degrees[b]; });
+
+    std::vector<int> order;
+    order.reserve(n);
+    std::vector<char> placed(n, 0);
+    // Scratch for the peripheral search: vertices seen in round `stamp`.
+    std::vector<int> seen(n, -1);
+    std::vector<int> frontier;
+    std::vector<int> next;
+    std::vector<int> neighbors;
+    int stamp = 0;
+
+    // Returns the depth of the BFS from `start` and its last level.
+    auto last_level = [&](int start, std::vector<int> &level)
+    {
+        ++stamp;
+        frontier.assign(1, start);
+        seen[start] = stamp;
+        int depth = 0;
+        while (true)
+        {
+            next.clear();
+            for (int v : frontier)
+            {
+                gr.for_each_neighbor(v, [&](int u)
+                                     {
+                    if (seen[u] != stamp)
+                    {
+                        seen[u] = stamp;
+                        next.push_back(u);
+                    } });
+            }
+            if (next.empty())
+            {
+                level = frontier;
+                return depth;
+            }
+            frontier.swap(next);
+            ++depth;
+        }
+    };
+
+    std::vector<int> level;
+    for (int root : by_degree)
+    {
+        if (placed[root])
+        {
+            continue;
+        }
+
+        int start = root;
+        int depth = last_level(start, level);
+        for (int round = 0; round < 8; ++round)
+        {
+            int candidate = *std::min_element(level.begin(), level.end(), [&](int a, int b)
+                                              { return degrees[a] < degrees[b]; });
+            int candidate_depth = last_level(candidate, level);
+            if (candidate_depth <= depth)
+            {
+                break;
+            }
+            start = candidate;
+            depth = candidate_depth;
+        }
+
+        std::size_t head = order.size();
+        order.push_back(start);
+        placed[start] = 1;
+        while (head < order.size())
+        {
+            int v = order[head++];
+            neighbors.clear();
+            gr.for_each_neighbor(v, [&](int u)
+                                 {
+                if (!placed[u])
+                {
+                    placed[u] = 1;
+                    neighbors.push_back(u);
+                } });
+            std::stable_sort(neighbors.begin(), neighbors.end(), [&](int a, int b)
+                             { return degrees[a] < degrees[b]; });
+            order.insert(order.end(), neighbors.begin(), neighbors.end());
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+// Max-priority queue over vertex scores that only ever change by one, kept
+// as one doubly linked list per score (the "unit heap" of Gorder).
+class unit_score_heap
+{
+private:
+    std::vector<int> score;
+    std::vector<int> prev;
+    std::vector<int> next;
+    std::vector<int> heads;
+    int top = 0;
+
+    void unlink(int v)
+    {
+        if (prev[v] >= 0)
+        {
+            next[prev[v]] = next[v];
+        }
+        else
+        {
+            heads[score[v]] = next[v];
+        }
+        if (next[v] >= 0)
+        {
+            prev[next[v]] = prev[v];
+        }
+    }
+
+    void link(int v)
+    {
+        if (score[v] >= static_cast<int>(heads.size()))
+        {
+            heads.resize(score[v] + 1, -1);
+        }
+        prev[v] = -1;
+        next[v] = heads[score[v]];
+        if (next[v] >= 0)
+        {
+            prev[next[v]] = v;
+        }
+        heads[score[v]] = v;
+        top = std::max(top, score[v]);
+    }
+
+public:
+    // Scores of removed vertices are never touched again.
+    static constexpr int removed = -1;
+
+    explicit unit_score_heap(int vertex_count)
+        : score(vertex_count, 0), prev(vertex_count, -1), next(vertex_count, -1), heads(1, -1)
+    {
+        for (int v = vertex_count - 1; v >= 0; --v)
+        {
+            link(v);
+        }
+    }
+
+    bool contains(int v) const { return score[v] != removed; }
+
+    void increment(int v)
+    {
+        if (contains(v))
+        {
+            unlink(v);
+            ++score[v];
+            link(v);
+        }
+    }
+
+    void decrement(int v)
+    {
+        if (contains(v) && score[v] > 0)
+        {
+            unlink(v);
+            --score[v];
+            link(v);
+        }
+    }
+
+    void remove(int v)
+    {
+        unlink(v);
+        score[v] = removed;
+    }
+
+    // Highest scoring vertex still present, or -1 when empty.
+    int max()
+    {
+        while (top > 0 && heads[top] < 0)
+        {
+            --top;
+        }
+        return heads[top];
+    }
+};
+
+// Gorder (Wei et al.): a greedy order that picks, as the next vertex, the
+// one most related to the last `window` placed vertices, counting both
+// direct edges and shared neighbors. Shared neighbors through hubs of degree
+// above sqrt(n) are not counted; they relate almost everything and would
+// make the pass quadratic.
+template <typename graph>
+std::vector<int> gorder_order(const graph &gr, int window = 5)
+{
+    if (window < 1)
+    {
+        throw std::invalid_argument("Gorder window must be positive");
+    }
+
+    int n = gr.vertex_count();
+    std::vector<int> order;
+    if (n == 0)
+    {
+        return order;
+    }
+    order.reserve(n);
+
+    std::vector<int> degrees = vertex_degrees(gr);
+    int hub_degree = std::max(16, static_cast<int>(std::sqrt(static_cast<double>(n))));
+    unit_score_heap heap(n);
+
+    // Applies `change` to every vertex related to v.
+    auto for_each_related = [&](int v, auto &&change)
+    {
+        gr.for_each_neighbor(v, [&](int u)
+                             {
+            change(u);
+            if (degrees[u] <= hub_degree)
+            {
+                gr.for_each_neighbor(u, [&](int w)
+                                     {
+                    if (w != v)
+                    {
+                        change(w);
+                    } });
+            } });
+    };
+
+    int start = static_cast<int>(std::max_element(degrees.begin(), degrees.end()) - degrees.begin());
+    for (int v = start; v >= 0; v = heap.max())
+    {
+        heap.remove(v);
+        order.push_back(v);
+        for_each_related(v, [&](int u)
+                         { heap.increment(u); });
+        if (static_cast<int>(order.size()) > window)
+        {
+            for_each_related(order[order.size() - 1 - window], [&](int u)
+                             { heap.decrement(u); });
+        }
+    }
+    return order;
+}
+
+template <typename graph>
+std::vector<int> compute_vertex_order(const graph &gr, vertex_order method)
+{
+    switch (method)
+    {
+    case vertex_order::reverse_cuthill_mckee:
+        return reverse_cuthill_mckee_order(gr);
+    case vertex_order::degree_descending:
+        return degree_descending_order(gr);
+    case vertex_order::gorder:
+        return gorder_order(gr);
+    }
+    throw std::invalid_argument("Unknown vertex order");
+}
+
+// A relabeled snapshot plus the mapping between its ids and the ids of the
+// graph it was built from.
+template <typename t_vertex, typename t_edge = std::monostate>
+struct reordered_graph
+{
+    csr_graph<t_vertex, t_edge> graph;
+    // to_original[new_id] = old_id and to_reordered[old_id] = new_id.
+    std::vector<int> to_original;
+    std::vector<int> to_reordered;
+
+    int original_id(int v) const { return to_original.at(v); }
+    int reordered_id(int v) const { return to_reordered.at(v); }
+
+    array_sequence<list_sequence<int>> original_ids(const array_sequence<list_sequence<int>> &groups) const
+    {
+        array_sequence<list_sequence<int>> mapped;
+        for (const auto &group : groups)
+        {
+            list_sequence<int> members;
+            for (int v : group)
+            {
+                members.append_element(original_id(v));
+            }
+            mapped.append_element(std::move(members));
+        }
+        return mapped;
+    }
+
+    // Per-vertex values (labels, distances) indexed by original id.
+    template <typename t_value>
+    std::vector<t_value> in_original_order(const std::vector<t_value> &values) const
+    {
+        std::vector<t_value> mapped(values.size());
+        for (std::size_t v = 0; v < values.size(); ++v)
+        {
+            mapped[to_original[v]] = values[v];
+        }
+        return mapped;
+    }
+};
+
+// Builds the relabeled copy of `source`. Each neighbor list is sorted by
+// new id, so scans walk memory forwards; weights move with their arcs.
+template <typename t_vertex, typename t_edge>
+reordered_graph<t_vertex, t_edge> reorder_vertices(const csr_graph<t_vertex, t_edge> &source,
+                                                   std::span<const int> order)
+{
+    int n = source.vertex_count();
+    if (static_cast<int>(order.size()) != n)
+    {
+        throw std::invalid_argument("Invalid vertex order");
+    }
+
+    reordered_graph<t_vertex, t_edge> result;
+    result.to_original.assign(order.begin(), order.end());
+    result.to_reordered.assign(n, -1);
+    for (int v = 0; v < n; ++v)
+    {
+        int old_id = order[v];
+        if (old_id < 0 || old_id >= n || result.to_reordered[old_id] != -1)
+        {
+            throw std::invalid_argument("Invalid vertex order");
+        }
+        result.to_reordered[old_id] = v;
+    }
+
+    std::vector<t_vertex> payloads;
+    std::vector<std::size_t> offsets;
+    std::vector<int> targets;
+    std::vector<t_edge> weights;
+    payloads.reserve(n);
+    offsets.reserve(n + 1);
+    offsets.push_back(0);
+    targets.reserve(source.arc_count());
+    std::vector<std::pair<int, std::size_t>> arcs;
+
+    for (int v = 0; v < n; ++v)
+    {
+        int old_id = order[v];
+        payloads.push_back(source.vertex_data(old_id));
+        std::span<const int> neighbors = source.neighbors(old_id);
+        arcs.clear();
+        for (std::size_t i = 0; i < neighbors.size(); ++i)
+        {
+            arcs.push_back({result.to_reordered[neighbors[i]], i});
+        }
+        std::sort(arcs.begin(), arcs.end());
+        for (auto [u, i] : arcs)
+        {
+            targets.push_back(u);
+            if constexpr (is_weighted_v<t_edge>)
+            {
+                weights.push_back(source.weight_array()[source.offset_array()[old_id] + i]);
+            }
+        }
+        offsets.push_back(targets.size());
+    }
+
+    if constexpr (is_weighted_v<t_edge>)
+    {
+        result.graph = csr_graph<t_vertex, t_edge>(std::move(payloads), std::move(offsets), std::move(targets),
+                                                   std::move(weights));
+    }
+    else
+    {
+        result.graph = csr_graph<t_vertex, t_edge>(std::move(payloads), std::move(offsets), std::move(targets));
+    }
+    return result;
+}
+
+template <typename t_vertex, typename t_edge>
+reordered_graph<t_vertex, t_edge> reorder_vertices(const csr_graph<t_vertex, t_edge> &source, vertex_order method)
+{
+    std::vector<int> order = compute_vertex_order(source, method);
+    return reorder_vertices(source, std::span<const int>(order));
+}